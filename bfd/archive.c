@@ -2292,6 +2292,135 @@ _bfd_write_archive_contents (bfd *arch)
   return false;
 }
 
+/* Add NAME, a symbol defined by ABFD, to the archive map of ARCH
+   being built in *MAP, which has room for *ORL_MAX entries.  */
+
+static bool
+add_armap_symbol (bfd *arch, struct orl **map, unsigned int *orl_max,
+		  unsigned int *orl_count, int *stridx,
+		  const char *name, bfd *abfd)
+{
+  bfd_size_type namelen;
+  size_t amt;
+
+  if (*orl_count == *orl_max)
+    {
+      struct orl *new_map;
+
+      *orl_max *= 2;
+      amt = *orl_max * sizeof (struct orl);
+      new_map = (struct orl *) bfd_realloc (*map, amt);
+      if (new_map == NULL)
+	return false;
+
+      *map = new_map;
+    }
+
+  namelen = strlen (name);
+  amt = sizeof (char *);
+  (*map)[*orl_count].name = (char **) bfd_alloc (arch, amt);
+  if ((*map)[*orl_count].name == NULL)
+    return false;
+  *((*map)[*orl_count].name) = (char *) bfd_alloc (arch, namelen + 1);
+  if (*((*map)[*orl_count].name) == NULL)
+    return false;
+  strcpy (*((*map)[*orl_count].name), name);
+  (*map)[*orl_count].u.abfd = abfd;
+  (*map)[*orl_count].namidx = *stridx;
+
+  *stridx += namelen + 1;
+  ++*orl_count;
+  return true;
+}
+
+/* The symbols in the map of an input archive, sorted by the position
+   of the member defining them.  */
+
+struct armap_by_member
+{
+  bfd *arch;
+  carsym **syms;
+  symindex count;
+};
+
+static int
+carsym_file_offset_cmp (const void *a, const void *b)
+{
+  const carsym *s1 = *(const carsym **) a;
+  const carsym *s2 = *(const carsym **) b;
+
+  if (s1->file_offset != s2->file_offset)
+    return s1->file_offset < s2->file_offset ? -1 : 1;
+
+  /* Keep the symbols of each member in their original order.  */
+  return s1 < s2 ? -1 : s1 > s2;
+}
+
+/* If CURRENT, a member of the archive being written to ARCH, is an
+   unchanged member of an input archive with a map, set *FIRST and
+   *COUNT to the symbols the map lists for it, using and updating
+   the sorted map in *BY_MEMBER.  Returns false if the symbols must
+   be read from CURRENT instead.  */
+
+static bool
+find_input_armap_symbols (bfd *arch, bfd *current,
+			  struct armap_by_member *by_member,
+			  carsym ***first, symindex *count)
+{
+  bfd *parent = current->my_archive;
+  struct areltdata *ared = arch_eltdata (current);
+  symindex lo, hi;
+
+  if ((arch->flags & BFD_ARCHIVE_REUSE_ARMAP) == 0
+      || parent == NULL
+      || ared == NULL
+      || ared->parent_cache == NULL
+      || bfd_is_thin_archive (arch)
+      || bfd_is_thin_archive (parent)
+      || !bfd_has_map (parent)
+      || bfd_ardata (parent)->symdefs == NULL)
+    return false;
+
+  if (by_member->arch != parent)
+    {
+      symindex i;
+
+      free (by_member->syms);
+      by_member->arch = NULL;
+      by_member->count = bfd_ardata (parent)->symdef_count;
+      by_member->syms = (carsym **) bfd_malloc (by_member->count
+						* sizeof (carsym *));
+      if (by_member->syms == NULL)
+	return false;
+      for (i = 0; i < by_member->count; i++)
+	by_member->syms[i] = bfd_ardata (parent)->symdefs + i;
+      qsort (by_member->syms, by_member->count, sizeof (carsym *),
+	     carsym_file_offset_cmp);
+      by_member->arch = parent;
+    }
+
+  /* Find the first symbol of the member whose header is at KEY.  */
+  lo = 0;
+  hi = by_member->count;
+  while (lo < hi)
+    {
+      symindex mid = lo + (hi - lo) / 2;
+
+      if (by_member->syms[mid]->file_offset < ared->key)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+  *first = by_member->syms + lo;
+  for (hi = lo;
+       hi < by_member->count && by_member->syms[hi]->file_offset == ared->key;
+       hi++)
+    ;
+  *count = hi - lo;
+  return true;
+}
+
 /* Note that the namidx for the first symbol is 0.  */
 
 bool
@@ -2306,6 +2435,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
   int stridx = 0;
   asymbol **syms = NULL;
   long syms_max = 0;
+  struct armap_by_member by_member = { NULL, NULL, 0 };
   bool ret;
   size_t amt;
   static bool report_plugin_err = true;
@@ -2336,6 +2466,23 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
        current != NULL;
        current = current->archive_next, elt_no++)
     {
+      carsym **known;
+      symindex known_count;
+
+      /* Members copied unchanged from an archive with a map keep the
+	 symbols listed there, without reading their symbol tables.  */
+      if (find_input_armap_symbols (arch, current, &by_member,
+				    &known, &known_count))
+	{
+	  symindex i;
+
+	  for (i = 0; i < known_count; i++)
+	    if (!add_armap_symbol (arch, &map, &orl_max, &orl_count, &stridx,
+				   known[i]->name, current))
+	      goto error_return;
+	  continue;
+	}
+
       if (bfd_check_format (current, bfd_object)
 	  && (bfd_get_file_flags (current) & HAS_SYMS) != 0)
 	{
@@ -2384,21 +2531,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
 		       || bfd_is_com_section (sec))
 		      && ! bfd_is_und_section (sec))
 		    {
-		      bfd_size_type namelen;
-		      struct orl *new_map;
-
 		      /* This symbol will go into the archive header.  */
-		      if (orl_count == orl_max)
-			{
-			  orl_max *= 2;
-			  amt = orl_max * sizeof (struct orl);
-			  new_map = (struct orl *) bfd_realloc (map, amt);
-			  if (new_map == NULL)
-			    goto error_return;
-
-			  map = new_map;
-			}
-
 		      if (bfd_lto_slim_symbol_p (current,
 						 syms[src_count]->name)
 			  && report_plugin_err)
@@ -2408,21 +2541,10 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
 			    (_("%pB: plugin needed to handle lto object"),
 			     current);
 			}
-		      namelen = strlen (syms[src_count]->name);
-		      amt = sizeof (char *);
-		      map[orl_count].name = (char **) bfd_alloc (arch, amt);
-		      if (map[orl_count].name == NULL)
-			goto error_return;
-		      *(map[orl_count].name) = (char *) bfd_alloc (arch,
-								   namelen + 1);
-		      if (*(map[orl_count].name) == NULL)
+		      if (!add_armap_symbol (arch, &map, &orl_max, &orl_count,
+					     &stridx, syms[src_count]->name,
+					     current))
 			goto error_return;
-		      strcpy (*(map[orl_count].name), syms[src_count]->name);
-		      map[orl_count].u.abfd = current;
-		      map[orl_count].namidx = stridx;
-
-		      stridx += namelen + 1;
-		      ++orl_count;
 		    }
 		}
 	    }
@@ -2440,6 +2562,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
 
   free (syms);
   free (map);
+  free (by_member.syms);
   if (first_name != NULL)
     bfd_release (arch, first_name);
 
@@ -2448,6 +2571,7 @@ _bfd_compute_and_write_armap (bfd *arch, unsigned int elength)
  error_return:
   free (syms);
   free (map);
+  free (by_member.syms);
   if (first_name != NULL)
     bfd_release (arch, first_name);
 
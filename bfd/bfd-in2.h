@@ -365,6 +365,21 @@ struct bfd_hash_table
   unsigned int frozen:1;
 };
 
+/* A record of a string which was not found in a hash table, see
+   bfd_hash_lookup_again.  */
+
+struct bfd_hash_miss
+{
+  /* The first entry in the bucket of the string when it was not
+     found.  */
+  struct bfd_hash_entry *head;
+  /* The size of the table at that time, or zero if nothing is
+     recorded.  */
+  unsigned int size;
+  /* The index of the bucket.  */
+  unsigned int index;
+};
+
 bool bfd_hash_table_init_n
    (struct bfd_hash_table *,
     struct bfd_hash_entry *(* /*newfunc*/)
@@ -383,6 +398,10 @@ struct bfd_hash_entry *bfd_hash_lookup
    (struct bfd_hash_table *, const char *,
     bool /*create*/, bool /*copy*/);
 
+struct bfd_hash_entry *bfd_hash_lookup_again
+   (struct bfd_hash_table *, const char *,
+    struct bfd_hash_miss * /*miss*/);
+
 struct bfd_hash_entry *bfd_hash_insert
    (struct bfd_hash_table *,
     const char *,
@@ -2061,6 +2080,15 @@ struct bfd
   /* Don't generate ELF section header.  */
 #define BFD_NO_SECTION_HEADER  0x800000
 
+  /* When writing an archive, copy the map entries of members which
+     are unchanged members of an input archive from that archive's
+     map, rather than reading their symbol tables.  */
+#define BFD_ARCHIVE_REUSE_ARMAP 0x1000000
+
+  /* Compress sections in this BFD with SHF_COMPRESSED zstd, in frames
+     which can be decompressed separately.  Used with BFD_COMPRESS_ZSTD.  */
+#define BFD_COMPRESS_ZSTD_SEEKABLE 0x2000000
+
   /* Flags bits which are for BFD use only.  */
 #define BFD_FLAGS_FOR_BFD_USE_MASK \
   (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_LINKER_CREATED \
@@ -2804,7 +2832,8 @@ enum compressed_debug_section_type
   COMPRESS_DEBUG_GNU_ZLIB = 1 << 1,
   COMPRESS_DEBUG_GABI_ZLIB = 1 << 2,
   COMPRESS_DEBUG_ZSTD = 1 << 3,
-  COMPRESS_UNKNOWN = 1 << 4
+  COMPRESS_DEBUG_ZSTD_SEEKABLE = 1 << 4,
+  COMPRESS_UNKNOWN = 1 << 5
 };
 
 /* Tuple for compressed_debug_section_type and their name.  */
@@ -2822,6 +2851,19 @@ enum compression_type
   ch_compress_zstd = 2         /* Compressed with zstd (www.zstandard.org).  */
 };
 
+/* A seekable zstd compressed section consists of independent zstd
+   frames, each of at most BFD_ZSTD_SEEKABLE_FRAME_SIZE uncompressed
+   bytes, followed by a skippable frame holding a seek table, as in the
+   seekable format in zstd's contrib directory.  The seek table is a
+   little-endian compressed size and uncompressed size for each frame,
+   then a footer of the number of frames, a descriptor byte and a magic
+   number.  */
+#define BFD_ZSTD_SEEKABLE_FRAME_SIZE (1024 * 1024)
+#define BFD_ZSTD_SKIPPABLE_MAGIC 0x184d2a5e
+#define BFD_ZSTD_SEEKABLE_MAGIC 0x8f92eab1
+#define BFD_ZSTD_SEEKABLE_ENTRY_SIZE 8
+#define BFD_ZSTD_SEEKABLE_FOOTER_SIZE 9
+
 static inline char *
 bfd_debug_name_to_zdebug (bfd *abfd, const char *name)
 {
@@ -2866,6 +2908,8 @@ bool bfd_convert_section_contents
    (bfd *ibfd, asection *isec, bfd *obfd,
     bfd_byte **ptr, bfd_size_type *ptr_size);
 
+void bfd_set_compression_threads (unsigned int threads);
+
 bool bfd_get_full_section_contents
    (bfd *abfd, asection *section, bfd_byte **ptr);
 
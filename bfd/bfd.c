@@ -227,6 +227,15 @@ CODE_FRAGMENT
 .  {* Don't generate ELF section header.  *}
 .#define BFD_NO_SECTION_HEADER	0x800000
 .
+.  {* When writing an archive, copy the map entries of members which
+.     are unchanged members of an input archive from that archive's
+.     map, rather than reading their symbol tables.  *}
+.#define BFD_ARCHIVE_REUSE_ARMAP 0x1000000
+.
+.  {* Compress sections in this BFD with SHF_COMPRESSED zstd, in frames
+.     which can be decompressed separately.  Used with BFD_COMPRESS_ZSTD.  *}
+.#define BFD_COMPRESS_ZSTD_SEEKABLE 0x2000000
+.
 .  {* Flags bits which are for BFD use only.  *}
 .#define BFD_FLAGS_FOR_BFD_USE_MASK \
 .  (BFD_IN_MEMORY | BFD_COMPRESS | BFD_DECOMPRESS | BFD_LINKER_CREATED \
@@ -40,7 +40,8 @@ EXTERNAL
 .  COMPRESS_DEBUG_GNU_ZLIB = 1 << 1,
 .  COMPRESS_DEBUG_GABI_ZLIB = 1 << 2,
 .  COMPRESS_DEBUG_ZSTD = 1 << 3,
-.  COMPRESS_UNKNOWN = 1 << 4
+.  COMPRESS_DEBUG_ZSTD_SEEKABLE = 1 << 4,
+.  COMPRESS_UNKNOWN = 1 << 5
 .};
 .
 .{* Tuple for compressed_debug_section_type and their name.  *}
@@ -58,6 +59,19 @@ EXTERNAL
 .  ch_compress_zstd = 2		{* Compressed with zstd (www.zstandard.org).  *}
 .};
 .
+.{* A seekable zstd compressed section consists of independent zstd
+.   frames, each of at most BFD_ZSTD_SEEKABLE_FRAME_SIZE uncompressed
+.   bytes, followed by a skippable frame holding a seek table, as in the
+.   seekable format in zstd's contrib directory.  The seek table is a
+.   little-endian compressed size and uncompressed size for each frame,
+.   then a footer of the number of frames, a descriptor byte and a magic
+.   number.  *}
+.#define BFD_ZSTD_SEEKABLE_FRAME_SIZE (1024 * 1024)
+.#define BFD_ZSTD_SKIPPABLE_MAGIC 0x184d2a5e
+.#define BFD_ZSTD_SEEKABLE_MAGIC 0x8f92eab1
+.#define BFD_ZSTD_SEEKABLE_ENTRY_SIZE 8
+.#define BFD_ZSTD_SEEKABLE_FOOTER_SIZE 9
+.
 .static inline char *
 .bfd_debug_name_to_zdebug (bfd *abfd, const char *name)
 .{
@@ -93,8 +107,16 @@ static const struct compressed_type_tuple compressed_debug_section_names[] =
   { COMPRESS_DEBUG_GNU_ZLIB, "zlib-gnu" },
   { COMPRESS_DEBUG_GABI_ZLIB, "zlib-gabi" },
   { COMPRESS_DEBUG_ZSTD, "zstd" },
+  { COMPRESS_DEBUG_ZSTD_SEEKABLE, "zstd-seekable" },
 };
 
+/* The number of threads zstd may use to compress a section.  */
+static unsigned int compression_threads;
+
+/* The size of the chunks in which compressed contents are read by
+   _bfd_decompress_section_contents.  */
+#define DECOMPRESS_CHUNK_SIZE (64 * 1024)
+
 /*
 FUNCTION
 	bfd_get_compression_algorithm
@@ -502,6 +524,229 @@ bfd_convert_section_contents (bfd *ibfd, sec_ptr isec, bfd *obfd,
   return true;
 }
 
+/*
+FUNCTION
+	bfd_set_compression_threads
+
+SYNOPSIS
+	void bfd_set_compression_threads (unsigned int threads);
+
+DESCRIPTION
+	Allow up to @var{threads} threads to be used to compress each
+	section with zstd.  The compressed contents are still a single
+	standard zstd frame, but may differ from those written by one
+	thread.  If @var{threads} is zero or one, or if zstd does not
+	support threads, sections are compressed by the calling thread.
+	Seekable zstd sections are always compressed by the calling
+	thread.
+*/
+
+void
+bfd_set_compression_threads (unsigned int threads)
+{
+  compression_threads = threads;
+}
+
+/* Read COUNT bytes at OFFSET of the compressed contents of SEC, which
+   is being decompressed, into BUF.  */
+
+static bool
+read_compressed_contents (bfd *abfd, asection *sec, bfd_byte *buf,
+			  file_ptr offset, bfd_size_type count)
+{
+  const unsigned int compress_status = sec->compress_status;
+  bfd_size_type save_size = sec->size;
+  bfd_size_type save_rawsize = sec->rawsize;
+  bool ret;
+
+  /* Clear rawsize, set size to compressed size and set compress_status
+     to COMPRESS_SECTION_NONE.  If the compressed size is bigger than
+     the uncompressed size, bfd_get_section_contents will fail.  */
+  sec->rawsize = 0;
+  sec->size = sec->compressed_size;
+  sec->compress_status = COMPRESS_SECTION_NONE;
+  ret = bfd_get_section_contents (abfd, sec, buf, offset, count);
+  /* Restore rawsize and size.  */
+  sec->rawsize = save_rawsize;
+  sec->size = save_size;
+  sec->compress_status = compress_status;
+  return ret;
+}
+
+#ifdef HAVE_ZSTD
+/* Compress SRC_SIZE bytes at SRC into at most DST_SIZE bytes at DST
+   with zstd.  Return the compressed size, or a zstd error code.  */
+
+static size_t
+compress_zstd (void *dst, size_t dst_size, const void *src, size_t src_size)
+{
+  ZSTD_CCtx *cctx;
+  size_t ret;
+
+  if (compression_threads <= 1
+      || (cctx = ZSTD_createCCtx ()) == NULL)
+    return ZSTD_compress (dst, dst_size, src, src_size, ZSTD_CLEVEL_DEFAULT);
+
+  /* This fails if zstd was built without thread support, in which case
+     the section is compressed by this thread.  */
+  ZSTD_CCtx_setParameter (cctx, ZSTD_c_nbWorkers, compression_threads);
+  ret = ZSTD_compress2 (cctx, dst, dst_size, src, src_size);
+  ZSTD_freeCCtx (cctx);
+  return ret;
+}
+
+/* Return the size of the seek table of a seekable zstd section with
+   NFRAMES frames, including the skippable frame header.  */
+
+static bfd_size_type
+zstd_seek_table_size (bfd_size_type nframes)
+{
+  return (8 + nframes * BFD_ZSTD_SEEKABLE_ENTRY_SIZE
+	  + BFD_ZSTD_SEEKABLE_FOOTER_SIZE);
+}
+
+/* Return the largest size SRC_SIZE bytes can take when compressed by
+   compress_zstd_seekable.  */
+
+static bfd_size_type
+compress_zstd_seekable_bound (bfd_size_type src_size)
+{
+  bfd_size_type nframes = ((src_size + BFD_ZSTD_SEEKABLE_FRAME_SIZE - 1)
+			   / BFD_ZSTD_SEEKABLE_FRAME_SIZE);
+
+  return (nframes * ZSTD_compressBound (BFD_ZSTD_SEEKABLE_FRAME_SIZE)
+	  + zstd_seek_table_size (nframes));
+}
+
+/* Compress SRC_SIZE bytes at SRC into at most DST_SIZE bytes at DST as
+   seekable zstd.  Return the compressed size, or a zstd error code.  */
+
+static size_t
+compress_zstd_seekable (bfd_byte *dst, size_t dst_size,
+			const bfd_byte *src, size_t src_size)
+{
+  ZSTD_CCtx *cctx;
+  bfd_byte *table, *p;
+  size_t nframes, i, out;
+
+  nframes = ((src_size + BFD_ZSTD_SEEKABLE_FRAME_SIZE - 1)
+	     / BFD_ZSTD_SEEKABLE_FRAME_SIZE);
+  table = bfd_malloc (zstd_seek_table_size (nframes));
+  if (table == NULL)
+    return (size_t) -1;
+  cctx = ZSTD_createCCtx ();
+  if (cctx == NULL)
+    {
+      free (table);
+      return (size_t) -1;
+    }
+
+  p = table + 8;
+  out = 0;
+  for (i = 0; i < nframes; i++)
+    {
+      size_t in = i * BFD_ZSTD_SEEKABLE_FRAME_SIZE;
+      size_t in_size = src_size - in;
+      size_t ret;
+
+      if (in_size > BFD_ZSTD_SEEKABLE_FRAME_SIZE)
+	in_size = BFD_ZSTD_SEEKABLE_FRAME_SIZE;
+      ret = ZSTD_compressCCtx (cctx, dst + out, dst_size - out,
+			       src + in, in_size, ZSTD_CLEVEL_DEFAULT);
+      if (ZSTD_isError (ret))
+	{
+	  out = ret;
+	  goto done;
+	}
+      out += ret;
+      bfd_putl32 (ret, p);
+      bfd_putl32 (in_size, p + 4);
+      p += BFD_ZSTD_SEEKABLE_ENTRY_SIZE;
+    }
+
+  bfd_putl32 (BFD_ZSTD_SKIPPABLE_MAGIC, table);
+  bfd_putl32 (zstd_seek_table_size (nframes) - 8, table + 4);
+  bfd_putl32 (nframes, p);
+  /* No checksums.  */
+  p[4] = 0;
+  bfd_putl32 (BFD_ZSTD_SEEKABLE_MAGIC, p + 5);
+  if (dst_size - out < zstd_seek_table_size (nframes))
+    out = (size_t) -1;
+  else
+    {
+      memcpy (dst + out, table, zstd_seek_table_size (nframes));
+      out += zstd_seek_table_size (nframes);
+    }
+
+ done:
+  ZSTD_freeCCtx (cctx);
+  free (table);
+  return out;
+}
+
+/* Set *IN_POS and *OUT_POS to the offsets in the compressed and
+   uncompressed contents of SEC of the start of the frame containing
+   uncompressed OFFSET, if SEC is seekable zstd.  Otherwise leave them
+   alone.  */
+
+static void
+find_zstd_seekable_frame (bfd *abfd, asection *sec, bfd_size_type offset,
+			  bfd_size_type *in_pos, bfd_size_type *out_pos)
+{
+  bfd_byte footer[BFD_ZSTD_SEEKABLE_FOOTER_SIZE];
+  bfd_byte *table, *p;
+  bfd_size_type nframes, table_size, in, out, i;
+
+  if (sec->compressed_size < *in_pos + 8 + sizeof (footer)
+      || !read_compressed_contents (abfd, sec, footer,
+				    sec->compressed_size - sizeof (footer),
+				    sizeof (footer))
+      || bfd_getl32 (footer + 5) != BFD_ZSTD_SEEKABLE_MAGIC
+      /* Checksums and reserved bits are not supported.  */
+      || (footer[4] & 0xfc) != 0)
+    return;
+
+  nframes = bfd_getl32 (footer);
+  table_size = zstd_seek_table_size (nframes);
+  if (table_size > sec->compressed_size - *in_pos)
+    return;
+  table = bfd_malloc (table_size);
+  if (table == NULL)
+    return;
+  if (!read_compressed_contents (abfd, sec, table,
+				 sec->compressed_size - table_size,
+				 table_size)
+      || bfd_getl32 (table) != BFD_ZSTD_SKIPPABLE_MAGIC
+      || bfd_getl32 (table + 4) != table_size - 8)
+    {
+      free (table);
+      return;
+    }
+
+  in = *in_pos;
+  out = 0;
+  p = table + 8;
+  for (i = 0; i < nframes; i++, p += BFD_ZSTD_SEEKABLE_ENTRY_SIZE)
+    {
+      bfd_size_type in_size = bfd_getl32 (p);
+      bfd_size_type out_size = bfd_getl32 (p + 4);
+
+      if (offset < out + out_size)
+	break;
+      in += in_size;
+      out += out_size;
+    }
+
+  /* Ignore a table which doesn't match the frames.  */
+  if (i < nframes && in <= sec->compressed_size - table_size)
+    {
+      *in_pos = in;
+      *out_pos = out;
+    }
+  free (table);
+}
+#endif
+
 static bool
 decompress_contents (bool is_zstd, bfd_byte *compressed_buffer,
 		     bfd_size_type compressed_size,
@@ -618,7 +863,14 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec)
     }
 
   if (!update)
-    compressed_size = compressBound (uncompressed_size) + new_header_size;
+    {
+      compressed_size = compressBound (uncompressed_size);
+#ifdef HAVE_ZSTD
+      if ((abfd->flags & BFD_COMPRESS_ZSTD_SEEKABLE) != 0)
+	compressed_size = compress_zstd_seekable_bound (uncompressed_size);
+#endif
+      compressed_size += new_header_size;
+    }
 
   buffer_size = compressed_size;
   buffer = bfd_alloc (abfd, buffer_size);
@@ -637,11 +889,16 @@ bfd_compress_section_contents (bfd *abfd, sec_ptr sec)
       if (abfd->flags & BFD_COMPRESS_ZSTD)
 	{
 #if HAVE_ZSTD
-	  compressed_size = ZSTD_compress (buffer + new_header_size,
-					   compressed_size,
-					   input_buffer,
-					   uncompressed_size,
-					   ZSTD_CLEVEL_DEFAULT);
+	  if ((abfd->flags & BFD_COMPRESS_ZSTD_SEEKABLE) != 0)
+	    compressed_size = compress_zstd_seekable (buffer + new_header_size,
+						      compressed_size,
+						      input_buffer,
+						      uncompressed_size);
+	  else
+	    compressed_size = compress_zstd (buffer + new_header_size,
+					     compressed_size,
+					     input_buffer,
+					     uncompressed_size);
 	  if (ZSTD_isError (compressed_size))
 	    {
 	      bfd_release (abfd, buffer);
@@ -708,9 +965,6 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
   bfd_size_type readsz = bfd_get_section_limit_octets (abfd, sec);
   bfd_size_type allocsz = bfd_get_section_alloc_size (abfd, sec);
   bfd_byte *p = *ptr;
-  bool ret;
-  bfd_size_type save_size;
-  bfd_size_type save_rawsize;
   bfd_byte *compressed_buffer;
   unsigned int compression_header_size;
   const unsigned int compress_status = sec->compress_status;
@@ -767,21 +1021,8 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
       compressed_buffer = (bfd_byte *) bfd_malloc (sec->compressed_size);
       if (compressed_buffer == NULL)
 	return false;
-      save_rawsize = sec->rawsize;
-      save_size = sec->size;
-      /* Clear rawsize, set size to compressed size and set compress_status
-	 to COMPRESS_SECTION_NONE.  If the compressed size is bigger than
-	 the uncompressed size, bfd_get_section_contents will fail.  */
-      sec->rawsize = 0;
-      sec->size = sec->compressed_size;
-      sec->compress_status = COMPRESS_SECTION_NONE;
-      ret = bfd_get_section_contents (abfd, sec, compressed_buffer,
-				      0, sec->compressed_size);
-      /* Restore rawsize and size.  */
-      sec->rawsize = save_rawsize;
-      sec->size = save_size;
-      sec->compress_status = compress_status;
-      if (!ret)
+      if (!read_compressed_contents (abfd, sec, compressed_buffer,
+				     0, sec->compressed_size))
 	goto fail_compressed;
 
       if (p == NULL)
@@ -831,6 +1072,154 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
     }
 }
 
+/* Read COUNT bytes at OFFSET of the uncompressed contents of SEC,
+   which is being decompressed, into LOCATION.  The compressed contents
+   are read and decompressed a chunk at a time, stopping at the end of
+   the range, so that reading the start of a large section is cheap and
+   the whole section is never held in memory.  No state is kept between
+   calls, so each call starts again at the beginning of the section.
+   A seekable zstd section is decompressed from the start of the frame
+   containing OFFSET, so reading any small range of it is cheap.  */
+
+bool
+_bfd_decompress_section_contents (bfd *abfd, asection *sec,
+				  void *location, file_ptr offset,
+				  bfd_size_type count)
+{
+  bool is_zstd = sec->compress_status == DECOMPRESS_SECTION_ZSTD;
+  bfd_size_type end = offset + count;
+  bfd_size_type in_pos, out_pos;
+  bfd_byte *buffer, *discard;
+  z_stream strm;
+#ifdef HAVE_ZSTD
+  ZSTD_DStream *zds = NULL;
+  ZSTD_inBuffer zin;
+#endif
+  bool ret = false;
+
+  in_pos = bfd_get_compression_header_size (abfd, sec);
+  if (in_pos == 0)
+    in_pos = 12;
+  out_pos = 0;
+
+  buffer = bfd_malloc (2 * DECOMPRESS_CHUNK_SIZE);
+  if (buffer == NULL)
+    return false;
+  discard = buffer + DECOMPRESS_CHUNK_SIZE;
+
+  memset (&strm, 0, sizeof (strm));
+  if (is_zstd)
+    {
+#ifdef HAVE_ZSTD
+      /* Start at the frame containing OFFSET if possible.  */
+      find_zstd_seekable_frame (abfd, sec, offset, &in_pos, &out_pos);
+      zds = ZSTD_createDStream ();
+      if (zds == NULL)
+	goto out;
+      zin.src = buffer;
+      zin.size = 0;
+      zin.pos = 0;
+#else
+      goto out;
+#endif
+    }
+  else if (inflateInit (&strm) != Z_OK)
+    goto out;
+
+  while (out_pos < end)
+    {
+      bfd_byte *next_out;
+      bfd_size_type avail_out, in_avail;
+      size_t in_used = 0, out_used = 0;
+
+      /* Output before the range is decompressed into DISCARD.  */
+      if (out_pos < (bfd_size_type) offset)
+	{
+	  next_out = discard;
+	  avail_out = offset - out_pos;
+	  if (avail_out > DECOMPRESS_CHUNK_SIZE)
+	    avail_out = DECOMPRESS_CHUNK_SIZE;
+	}
+      else
+	{
+	  next_out = (bfd_byte *) location + (out_pos - offset);
+	  avail_out = end - out_pos;
+	}
+
+#ifdef HAVE_ZSTD
+      in_avail = is_zstd ? zin.size - zin.pos : strm.avail_in;
+#else
+      in_avail = strm.avail_in;
+#endif
+      if (in_avail == 0 && in_pos < sec->compressed_size)
+	{
+	  in_avail = sec->compressed_size - in_pos;
+	  if (in_avail > DECOMPRESS_CHUNK_SIZE)
+	    in_avail = DECOMPRESS_CHUNK_SIZE;
+	  if (!read_compressed_contents (abfd, sec, buffer, in_pos, in_avail))
+	    goto out;
+	  in_pos += in_avail;
+#ifdef HAVE_ZSTD
+	  zin.size = in_avail;
+	  zin.pos = 0;
+#endif
+	  strm.next_in = buffer;
+	  strm.avail_in = in_avail;
+	}
+
+      if (is_zstd)
+	{
+#ifdef HAVE_ZSTD
+	  ZSTD_outBuffer zout = { next_out, avail_out, 0 };
+	  size_t in_start = zin.pos;
+
+	  if (ZSTD_isError (ZSTD_decompressStream (zds, &zout, &zin)))
+	    goto out;
+	  in_used = zin.pos - in_start;
+	  out_used = zout.pos;
+#endif
+	}
+      else
+	{
+	  int rc;
+
+	  strm.next_out = next_out;
+	  strm.avail_out = avail_out;
+	  if (strm.avail_out != avail_out)
+	    strm.avail_out = (uInt) -1;
+	  in_used = strm.avail_in;
+	  out_used = strm.avail_out;
+	  rc = inflate (&strm, Z_NO_FLUSH);
+	  in_used -= strm.avail_in;
+	  out_used -= strm.avail_out;
+	  /* As in decompress_contents, the section may consist of several
+	     compressed buffers concatenated together.  */
+	  if (rc == Z_STREAM_END)
+	    rc = inflateReset (&strm);
+	  if (rc != Z_OK && rc != Z_BUF_ERROR)
+	    goto out;
+	}
+
+      /* Stop if the compressed contents end too early.  */
+      if (in_used == 0 && out_used == 0)
+	goto out;
+      out_pos += out_used;
+    }
+  ret = true;
+
+ out:
+  if (!ret)
+    bfd_set_error (bfd_error_bad_value);
+#ifdef HAVE_ZSTD
+  if (zds != NULL)
+    ZSTD_freeDStream (zds);
+#endif
+  if (!is_zstd)
+    inflateEnd (&strm);
+  free (buffer);
+  return ret;
+}
+
 /*
 FUNCTION
 	bfd_is_section_compressed_info
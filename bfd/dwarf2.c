@@ -411,6 +411,11 @@ struct comp_unit
   /* Number of functions in the function_table and sorted_function_table.  */
   bfd_size_type number_of_functions;
 
+  /* The address and result of the last successful lookup in the
+     function table.  */
+  bfd_vma last_func_addr;
+  struct funcinfo *last_func;
+
   /* A list of the variables found in this comp. unit.  */
   struct varinfo *variable_table;
 
@@ -1818,6 +1823,10 @@ struct line_info_table
   struct fileinfo*	files;
   struct line_sequence* sequences;
   struct line_info*	lcl_head;   /* Local head; used in 'add_line_info'.  */
+  /* The sequence and index in its line_info_lookup of the line found
+     by the last successful lookup, used to speed up the next one.  */
+  struct line_sequence* last_seq;
+  bfd_size_type		last_line;
 };
 
 /* Remember some information about each function.  If the function is
@@ -2863,6 +2872,9 @@ decode_line_info (struct comp_unit *unit)
 
   table->lcl_head = NULL;
 
+  table->last_seq = NULL;
+  table->last_line = 0;
+
   if (lh.version >= 5)
     {
       /* Read directory table.  */
@@ -3127,9 +3139,34 @@ lookup_address_in_line_info_table (struct line_info_table *table,
 {
   struct line_sequence *seq = NULL;
   struct line_info *info;
-  int low, high, mid;
+  bfd_size_type low, high, mid;
+
+  /* Check the line found by the last lookup, and the few following
+     it, before searching.  Lookups of nearby addresses, as when
+     translating sorted addresses or disassembling with line numbers,
+     mostly hit one of them.  Several lines may start at the same
+     address, so look a little further than the next one.
+     sort_line_sequences trims overlapping sequences, so the lines of
+     a sequence can start before its low_pc.  Only use the cache if ADDR
+     is in SEQ, which is then the sequence the search below finds.  */
+  seq = table->last_seq;
+  if (seq != NULL
+      && addr >= seq->low_pc
+      && addr < seq->last_line->address)
+    for (mid = table->last_line;
+	 mid < table->last_line + 4 && mid + 1 < seq->num_lines;
+	 mid++)
+      {
+	info = seq->line_info_lookup[mid];
+	if (addr < info->address)
+	  break;
+	if (addr < seq->line_info_lookup[mid + 1]->address
+	    && !(info->end_sequence || info == seq->last_line))
+	  goto found;
+      }
 
   /* Binary search the array of sequences.  */
+  seq = NULL;
   low = 0;
   high = table->num_sequences;
   while (low < high)
@@ -3173,6 +3210,9 @@ lookup_address_in_line_info_table (struct line_info_table *table,
       && addr < seq->line_info_lookup[mid + 1]->address
       && !(info->end_sequence || info == seq->last_line))
     {
+    found:
+      table->last_seq = seq;
+      table->last_line = mid;
       *filename_ptr = info->filename;
       *linenumber_ptr = info->line;
       if (discriminator_ptr)
@@ -3323,6 +3363,14 @@ lookup_address_in_function_table (struct comp_unit *unit,
   if (number_of_functions == 0)
     return false;
 
+  /* Repeated lookups of the same address are common, e.g. when
+     translating sampled program counters.  */
+  if (unit->last_func != NULL && unit->last_func_addr == addr)
+    {
+      *function_ptr = unit->last_func;
+      return true;
+    }
+
   if (!build_lookup_funcinfo_table (unit))
     return false;
 
@@ -3380,6 +3428,8 @@ lookup_address_in_function_table (struct comp_unit *unit,
   if (!best_fit)
     return false;
 
+  unit->last_func_addr = addr;
+  unit->last_func = best_fit;
   *function_ptr = best_fit;
   return true;
 }
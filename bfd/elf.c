@@ -1046,7 +1046,10 @@ _bfd_elf_make_section_from_shdr (bfd *abfd,
 	      if ((abfd->flags & BFD_COMPRESS_GABI) != 0)
 		new_ch_type = ((abfd->flags & BFD_COMPRESS_ZSTD) != 0
 			       ? ch_compress_zstd : ch_compress_zlib);
-	      if (new_ch_type != ch_type)
+	      /* Seekable zstd can't be told apart from the header, so
+		 always compress zstd sections again.  */
+	      if (new_ch_type != ch_type
+		  || (abfd->flags & BFD_COMPRESS_ZSTD_SEEKABLE) != 0)
 		action = compress;
 	    }
 	}
@@ -6196,6 +6196,43 @@ _bfd_elf_archive_symbol_lookup (bfd *abfd,
   return h;
 }
 
+/* Like _bfd_elf_archive_symbol_lookup, but don't look up NAME again if
+   MISS shows that it still isn't in the linker hash table.  */
+
+static struct bfd_link_hash_entry *
+elf_archive_symbol_lookup_again (bfd *abfd,
+				 struct bfd_link_info *info,
+				 const char *name,
+				 struct bfd_hash_miss *miss)
+{
+  struct bfd_hash_miss last = *miss;
+  struct bfd_link_hash_entry *h;
+  const char *p;
+
+  h = bfd_link_hash_lookup_again (info->hash, name, miss);
+  if (h != NULL)
+    return h;
+
+  /* NAME was skipped, so it has been added to first hash already.  */
+  if (miss->size == last.size
+      && miss->index == last.index
+      && miss->head == last.head)
+    return h;
+
+  /* A default version is also looked up under other names, which may
+     be added to any bucket, so don't remember it.  */
+  p = strchr (name, ELF_VER_CHR);
+  if (p != NULL && p[1] == ELF_VER_CHR)
+    {
+      memset (miss, 0, sizeof (*miss));
+      return _bfd_elf_archive_symbol_lookup (abfd, info, name);
+    }
+
+  if (is_elf_hash_table (info->hash))
+    elf_link_add_to_first_hash (abfd, info, name, false);
+  return h;
+}
+
 /* Add symbols from an ELF archive file to the linker hash table.  We
    don't use _bfd_generic_link_add_archive_symbols because we need to
    handle versioned symbols.
@@ -6214,6 +6251,8 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 {
   symindex c;
   unsigned char *included = NULL;
+  struct bfd_hash_miss *misses = NULL;
+  struct bfd_hash_table *first_hash = NULL;
   carsym *symdefs;
   bool loop;
   size_t amt;
@@ -6245,6 +6284,20 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
   bed = get_elf_backend_data (abfd);
   archive_symbol_lookup = bed->elf_backend_archive_symbol_lookup;
 
+  /* Most symbols in a large archive are never referenced.  With the
+     default lookup, remember where each one was not found in the hash
+     table, so that later passes need not look it up again unless it
+     may have been added.  */
+  if (archive_symbol_lookup == _bfd_elf_archive_symbol_lookup)
+    {
+      amt = c * sizeof (*misses);
+      misses = (struct bfd_hash_miss *) bfd_zmalloc (amt);
+      if (misses == NULL)
+	goto error_return;
+      if (is_elf_hash_table (info->hash))
+	first_hash = elf_hash_table (info)->first_hash;
+    }
+
   do
     {
       file_ptr last;
@@ -6272,7 +6325,11 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 	      continue;
 	    }
 
-	  h = archive_symbol_lookup (abfd, info, symdef->name);
+	  if (misses != NULL)
+	    h = elf_archive_symbol_lookup_again (abfd, info, symdef->name,
+						 &misses[i]);
+	  else
+	    h = archive_symbol_lookup (abfd, info, symdef->name);
 	  if (h == (struct bfd_link_hash_entry *) -1)
 	    goto error_return;
 
@@ -6367,6 +6424,16 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 	  if (!bfd_link_add_symbols (element, info))
 	    goto error_return;
 
+	  /* Symbols which were skipped must be looked up again if first
+	     hash was created, so that they are added to it.  */
+	  if (misses != NULL
+	      && is_elf_hash_table (info->hash)
+	      && elf_hash_table (info)->first_hash != first_hash)
+	    {
+	      first_hash = elf_hash_table (info)->first_hash;
+	      memset (misses, 0, c * sizeof (*misses));
+	    }
+
 	  /* If there are any new undefined symbols, we need to make
 	     another pass through the archive in order to see whether
 	     they can be defined.  FIXME: This isn't perfect, because
@@ -6396,10 +6463,12 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
     }
   while (loop);
 
+  free (misses);
   free (included);
   return true;
 
  error_return:
+  free (misses);
   free (included);
   return false;
 }
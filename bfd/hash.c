@@ -339,6 +339,21 @@ EXTERNAL
 .  unsigned int frozen:1;
 .};
 .
+.{* A record of a string which was not found in a hash table, see
+.   bfd_hash_lookup_again.  *}
+.
+.struct bfd_hash_miss
+.{
+.  {* The first entry in the bucket of the string when it was not
+.     found.  *}
+.  struct bfd_hash_entry *head;
+.  {* The size of the table at that time, or zero if nothing is
+.     recorded.  *}
+.  unsigned int size;
+.  {* The index of the bucket.  *}
+.  unsigned int index;
+.};
+.
 */
 
 /* The default number of entries to use when creating a hash table.  */
@@ -586,6 +601,57 @@ bfd_hash_lookup (struct bfd_hash_table *table,
   return bfd_hash_insert (table, string, hash);
 }
 
+/*
+FUNCTION
+	bfd_hash_lookup_again
+
+SYNOPSIS
+	struct bfd_hash_entry *bfd_hash_lookup_again
+	  (struct bfd_hash_table *, const char *,
+	   struct bfd_hash_miss *{*miss*});
+
+DESCRIPTION
+	Look up a string in a hash table, without creating it, for
+	callers which look up the same strings many times.  If
+	@var{miss} records that the string was not found, and no entry
+	has been added to its bucket since, return NULL without
+	hashing the string again.  Otherwise search the table, and if
+	the string is not found record that in @var{miss}, which must
+	be zeroed before the first lookup of the string.
+*/
+
+struct bfd_hash_entry *
+bfd_hash_lookup_again (struct bfd_hash_table *table,
+		       const char *string,
+		       struct bfd_hash_miss *miss)
+{
+  unsigned long hash;
+  struct bfd_hash_entry *hashp;
+  unsigned int _index;
+
+  /* New entries are always put first in their bucket, so if the first
+     entry is the same the string is still not there.  */
+  if (miss->size == table->size
+      && table->table[miss->index] == miss->head)
+    return NULL;
+
+  hash = bfd_hash_hash (string, NULL);
+  _index = hash % table->size;
+  for (hashp = table->table[_index];
+       hashp != NULL;
+       hashp = hashp->next)
+    {
+      if (hashp->hash == hash
+	  && strcmp (hashp->string, string) == 0)
+	return hashp;
+    }
+
+  miss->head = table->table[_index];
+  miss->size = table->size;
+  miss->index = _index;
+  return NULL;
+}
+
 /*
 FUNCTION
 	bfd_hash_insert
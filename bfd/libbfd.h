@@ -269,6 +269,10 @@ extern bool _bfd_generic_new_section_hook
 extern bool _bfd_generic_get_section_contents
   (bfd *, asection *, void *, file_ptr, bfd_size_type) ATTRIBUTE_HIDDEN;
 
+/* Read part of the uncompressed contents of a compressed section.  */
+extern bool _bfd_decompress_section_contents
+  (bfd *, asection *, void *, file_ptr, bfd_size_type) ATTRIBUTE_HIDDEN;
+
 /* Generic routines to use for BFD_JUMP_TABLE_COPY.  Use
    BFD_JUMP_TABLE_COPY (_bfd_generic).  */
 
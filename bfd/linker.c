@@ -540,6 +540,29 @@ bfd_link_hash_lookup (struct bfd_link_hash_table *table,
   return ret;
 }
 
+/* Look up a symbol in a link hash table which is looked up many times,
+   skipping the search if MISS shows it still isn't there.  */
+
+struct bfd_link_hash_entry *
+bfd_link_hash_lookup_again (struct bfd_link_hash_table *table,
+			    const char *string,
+			    struct bfd_hash_miss *miss)
+{
+  struct bfd_link_hash_entry *ret;
+
+  ret = ((struct bfd_link_hash_entry *)
+	 bfd_hash_lookup_again (&table->table, string, miss));
+
+  if (ret != NULL)
+    {
+      while (ret->type == bfd_link_hash_indirect
+	     || ret->type == bfd_link_hash_warning)
+	ret = ret->u.i.link;
+    }
+
+  return ret;
+}
+
 /* Look up a symbol in the main linker hash table if the symbol might
    be wrapped.  This should only be used for references to an
    undefined symbol, not for definitions of a symbol.  */
@@ -934,6 +957,7 @@ _bfd_generic_link_add_archive_symbols
   bool loop;
   bfd_size_type amt;
   unsigned char *included;
+  struct bfd_hash_miss *misses;
 
   if (! bfd_has_map (abfd))
     {
@@ -952,6 +976,17 @@ _bfd_generic_link_add_archive_symbols
   if (included == NULL)
     return false;
 
+  /* Most symbols in a large archive are never referenced.  Remember
+     where each one was not found in the hash table, so that later
+     passes need not look it up again unless it may have been added.  */
+  amt = bfd_ardata (abfd)->symdef_count * sizeof (*misses);
+  misses = (struct bfd_hash_miss *) bfd_zmalloc (amt);
+  if (misses == NULL)
+    {
+      free (included);
+      return false;
+    }
+
   do
     {
       carsym *arsyms;
@@ -981,8 +1016,8 @@ _bfd_generic_link_add_archive_symbols
 	  if (arsym->name == NULL)
 	    goto error_return;
 
-	  h = bfd_link_hash_lookup (info->hash, arsym->name,
-				    false, false, true);
+	  h = bfd_link_hash_lookup_again (info->hash, arsym->name,
+					  &misses[indx]);
 
 	  if (h == NULL
 	      && info->pei386_auto_import
@@ -1040,10 +1075,12 @@ _bfd_generic_link_add_archive_symbols
 	}
     } while (loop);
 
+  free (misses);
   free (included);
   return true;
 
  error_return:
+  free (misses);
   free (included);
   return false;
 }
@@ -1555,6 +1555,16 @@ DESCRIPTION
 	with zeroes. If no errors occur, <<TRUE>> is returned, else
 	<<FALSE>>.
 
+	If the section is being decompressed, the data is read from its
+	uncompressed contents, decompressing only as much of the section
+	as is needed.  No decompression state is kept between calls, so
+	each call decompresses the section from its start up to the end
+	of the range.  Reading a large compressed section in many small
+	consecutive pieces therefore takes time quadratic in its size;
+	use <<bfd_get_full_section_contents>> to read all of it.  A
+	section compressed as seekable zstd is instead decompressed from
+	the start of the 1 MiB frame containing @var{offset}.
+
 */
 bool
 bfd_get_section_contents (bfd *abfd,
@@ -1630,6 +1640,11 @@ bfd_get_section_contents (bfd *abfd,
       return true;
     }
 
+  if (section->compress_status == DECOMPRESS_SECTION_ZLIB
+      || section->compress_status == DECOMPRESS_SECTION_ZSTD)
+    return _bfd_decompress_section_contents (abfd, section, location,
+					     offset, count);
+
   return BFD_SEND (abfd, _bfd_get_section_contents,
 		   (abfd, section, location, offset, count));
 }
@@ -45,6 +45,8 @@ static bool with_functions;	/* -f, show function names.  */
 static bool do_demangle;	/* -C, demangle names.  */
 static bool pretty_print;	/* -p, print on one line.  */
 static bool base_names;		/* -s, strip directory names.  */
+static bool sort_addresses;	/* --sort-addresses.  */
+static bool server_mode;	/* --server.  */
 
 /* Flags passed to the name demangler.  */
 static int demangle_flags = DMGL_PARAMS | DMGL_ANSI;
@@ -55,6 +57,12 @@ static char **addr;		/* Hex addresses to process.  */
 static long symcount;
 static asymbol **syms;		/* Symbol table.  */
 
+enum option_values
+{
+  OPTION_SORT_ADDRESSES = 150,
+  OPTION_SERVER
+};
+
 static struct option long_options[] =
 {
   {"addresses", no_argument, NULL, 'a'},
@@ -69,6 +77,8 @@ static struct option long_options[] =
   {"no-recurse-limit", no_argument, NULL, 'r'},
   {"no-recursion-limit", no_argument, NULL, 'r'},  
   {"section", required_argument, NULL, 'j'},
+  {"server", no_argument, NULL, OPTION_SERVER},
+  {"sort-addresses", no_argument, NULL, OPTION_SORT_ADDRESSES},
   {"target", required_argument, NULL, 'b'},
   {"help", no_argument, NULL, 'H'},
   {"version", no_argument, NULL, 'V'},
@@ -98,6 +108,10 @@ usage (FILE *stream, int status)
   -j --section=<name>    Read section-relative offsets instead of addresses\n\
   -p --pretty-print      Make the output easier to read for humans\n\
   -s --basenames         Strip directory names\n\
+     --server            Keep files open and read requests for many files\n\
+                          from stdin, see the manual\n\
+     --sort-addresses    Read all addresses first, then translate them in\n\
+                          increasing order\n\
   -f --functions         Show function names\n\
   -C --demangle[=style]  Demangle function names\n\
   -R --recurse-limit     Enable a limit on recursion whilst demangling.  [Default]\n\
@@ -280,8 +294,163 @@ is_symbol (char *adr, char **symp, size_t *offset)
   return true;
 }
 
+/* Parse the hexadecimal or symbolic with offset address ADR.  */
+
+static bfd_vma
+parse_address (bfd *abfd, char *adr)
+{
+  char *symp;
+  size_t offset;
+  bfd_vma vma;
+
+  if (is_symbol (adr, &symp, &offset))
+    vma = lookup_symbol (abfd, symp, offset);
+  else
+    vma = bfd_scan_vma (adr, NULL, 16);
+  if (bfd_get_flavour (abfd) == bfd_target_elf_flavour)
+    {
+      const struct elf_backend_data *bed = get_elf_backend_data (abfd);
+      bfd_vma sign = (bfd_vma) 1 << (bed->s->arch_size - 1);
+
+      vma &= (sign << 1) - 1;
+      if (bed->sign_extend_vma)
+	vma = (vma ^ sign) - sign;
+    }
+  return vma;
+}
+
+/* Print the result for an address that could not be translated.  */
+
+static void
+print_unknown (void)
+{
+  if (with_functions)
+    {
+      if (pretty_print)
+	printf ("?? ");
+      else
+	printf ("??\n");
+    }
+  printf ("??:0\n");
+}
+
+/* Translate PC into file_name:line_number and optionally function
+   name, and print the result.  */
+
+static void
+translate_pc (bfd *abfd, asection *section)
+{
+  if (with_addresses)
+    {
+      printf ("0x");
+      bfd_printf_vma (abfd, pc);
+
+      if (pretty_print)
+	printf (": ");
+      else
+	printf ("\n");
+    }
+
+  found = false;
+  if (section)
+    find_offset_in_section (abfd, section);
+  else
+    bfd_map_over_sections (abfd, find_address_in_section, NULL);
+
+  if (! found)
+    print_unknown ();
+  else
+    {
+      while (1)
+	{
+	  if (with_functions)
+	    {
+	      const char *name;
+	      char *alloc = NULL;
+
+	      name = functionname;
+	      if (name == NULL || *name == '\0')
+		name = "??";
+	      else if (do_demangle)
+		{
+		  alloc = bfd_demangle (abfd, name, demangle_flags);
+		  if (alloc != NULL)
+		    name = alloc;
+		}
+
+	      printf ("%s", name);
+	      if (pretty_print)
+		/* Note for translators:  This printf is used to join the
+		   function name just printed above to the line number/
+		   file name pair that is about to be printed below.  Eg:
+
+		     foo at 123:bar.c  */
+		printf (_(" at "));
+	      else
+		printf ("\n");
+
+	      free (alloc);
+	    }
+
+	  if (base_names && filename != NULL)
+	    {
+	      char *h;
+
+	      h = strrchr (filename, '/');
+	      if (h != NULL)
+		filename = h + 1;
+	    }
+
+	  printf ("%s:", filename ? filename : "??");
+	  if (line != 0)
+	    {
+	      if (discriminator != 0)
+		printf ("%u (discriminator %u)\n", line, discriminator);
+	      else
+		printf ("%u\n", line);
+	    }
+	  else
+	    printf ("?\n");
+	  if (!unwind_inlines)
+	    found = false;
+	  else
+	    found = bfd_find_inliner_info (abfd, &filename, &functionname,
+					   &line);
+	  if (! found)
+	    break;
+	  if (pretty_print)
+	    /* Note for translators: This printf is used to join the
+	       line number/file name pair that has just been printed with
+	       the line number/file name pair that is going to be printed
+	       by the next iteration of the while loop.  Eg:
+
+		 123:bar.c (inlined by) 456:main.c  */
+	    printf (_(" (inlined by) "));
+	}
+    }
+}
+
+/* Compare two addresses, for qsort.  */
+
+static int
+compare_vma (const void *a, const void *b)
+{
+  bfd_vma va = *(const bfd_vma *) a;
+  bfd_vma vb = *(const bfd_vma *) b;
+
+  if (va < vb)
+    return -1;
+  if (va > vb)
+    return 1;
+  return 0;
+}
+
 /* Read hexadecimal or symbolic with offset addresses from stdin, translate into
-   file_name:line_number and optionally function name.  */
+   file_name:line_number and optionally function name.  If sort_addresses
+   is set, all the addresses are read before any is translated, and they
+   are translated in increasing order.  Neighbouring addresses usually
+   belong to the same compilation unit and line sequence, so this lets
+   the DWARF reader reuse the results of its previous lookup.  */
 
 static void
 translate_addresses (bfd *abfd, asection *section)
@@ -289,8 +458,9 @@ translate_addresses (bfd *abfd, asection *section)
   int read_stdin = (naddr == 0);
   char *adr;
   char addr_hex[100];
-  char *symp;
-  size_t offset;
+  bfd_vma *sorted = NULL;
+  size_t nsorted = 0;
+  size_t sorted_alloc = 0;
 
   for (;;)
     {
@@ -308,142 +478,64 @@ translate_addresses (bfd *abfd, asection *section)
 	  adr = *addr++;
 	}
 
-      if (is_symbol (adr, &symp, &offset))
-        pc = lookup_symbol (abfd, symp, offset);
-      else
-        pc = bfd_scan_vma (adr, NULL, 16);
-      if (bfd_get_flavour (abfd) == bfd_target_elf_flavour)
-	{
-	  const struct elf_backend_data *bed = get_elf_backend_data (abfd);
-	  bfd_vma sign = (bfd_vma) 1 << (bed->s->arch_size - 1);
-
-	  pc &= (sign << 1) - 1;
-	  if (bed->sign_extend_vma)
-	    pc = (pc ^ sign) - sign;
-	}
-
-      if (with_addresses)
-        {
-          printf ("0x");
-          bfd_printf_vma (abfd, pc);
-
-          if (pretty_print)
-            printf (": ");
-          else
-            printf ("\n");
-        }
+      pc = parse_address (abfd, adr);
 
-      found = false;
-      if (section)
-	find_offset_in_section (abfd, section);
-      else
-	bfd_map_over_sections (abfd, find_address_in_section, NULL);
-
-      if (! found)
+      if (sort_addresses)
 	{
-	  if (with_functions)
+	  if (nsorted == sorted_alloc)
 	    {
-	      if (pretty_print)
-		printf ("?? ");
-	      else
-		printf ("??\n");
+	      sorted_alloc = sorted_alloc ? sorted_alloc * 2 : 256;
+	      sorted = xrealloc (sorted, sorted_alloc * sizeof (*sorted));
 	    }
-	  printf ("??:0\n");
-	}
-      else
-	{
-	  while (1)
-            {
-              if (with_functions)
-                {
-                  const char *name;
-                  char *alloc = NULL;
-
-                  name = functionname;
-                  if (name == NULL || *name == '\0')
-                    name = "??";
-                  else if (do_demangle)
-                    {
-                      alloc = bfd_demangle (abfd, name, demangle_flags);
-                      if (alloc != NULL)
-                        name = alloc;
-                    }
-
-                  printf ("%s", name);
-                  if (pretty_print)
-		    /* Note for translators:  This printf is used to join the
-		       function name just printed above to the line number/
-		       file name pair that is about to be printed below.  Eg:
-
-		         foo at 123:bar.c  */
-                    printf (_(" at "));
-                  else
-                    printf ("\n");
-
-		  free (alloc);
-                }
-
-              if (base_names && filename != NULL)
-                {
-                  char *h;
-
-                  h = strrchr (filename, '/');
-                  if (h != NULL)
-                    filename = h + 1;
-                }
-
-              printf ("%s:", filename ? filename : "??");
-	      if (line != 0)
-                {
-                  if (discriminator != 0)
-                    printf ("%u (discriminator %u)\n", line, discriminator);
-                  else
-                    printf ("%u\n", line);
-                }
-	      else
-		printf ("?\n");
-              if (!unwind_inlines)
-                found = false;
-              else
-                found = bfd_find_inliner_info (abfd, &filename, &functionname,
-					       &line);
-              if (! found)
-                break;
-              if (pretty_print)
-		/* Note for translators: This printf is used to join the
-		   line number/file name pair that has just been printed with
-		   the line number/file name pair that is going to be printed
-		   by the next iteration of the while loop.  Eg:
-
-		     123:bar.c (inlined by) 456:main.c  */
-                printf (_(" (inlined by) "));
-            }
+	  sorted[nsorted++] = pc;
+	  continue;
 	}
 
+      translate_pc (abfd, section);
+
       /* fflush() is essential for using this command as a server
          child process that reads addresses from a pipe and responds
          with line number information, processing one address at a
          time.  */
       fflush (stdout);
     }
+
+  if (sort_addresses)
+    {
+      size_t i;
+
+      if (nsorted > 1)
+	qsort (sorted, nsorted, sizeof (*sorted), compare_vma);
+      for (i = 0; i < nsorted; i++)
+	{
+	  pc = sorted[i];
+	  translate_pc (abfd, section);
+	}
+      fflush (stdout);
+      free (sorted);
+    }
 }
 
-/* Process a file.  Returns an exit value for main().  */
+/* Open FILE_NAME and check that addresses can be translated using it.
+   If SECTION_NAME is not NULL, set *SECTION to that section, otherwise
+   to NULL.  Returns NULL on failure, after reporting the error.  */
 
-static int
-process_file (const char *file_name, const char *section_name,
-	      const char *target)
+static bfd *
+open_file (const char *file_name, const char *section_name,
+	   const char *target, asection **section)
 {
   bfd *abfd;
-  asection *section;
   char **matching;
 
   if (get_file_size (file_name) < 1)
-    return 1;
+    return NULL;
 
   abfd = bfd_openr (file_name, target);
   if (abfd == NULL)
-    bfd_fatal (file_name);
+    {
+      bfd_nonfatal (file_name);
+      return NULL;
+    }
 
   /* Decompress sections.  */
   abfd->flags |= BFD_DECOMPRESS;
@@ -452,7 +544,7 @@ process_file (const char *file_name, const char *section_name,
     {
       non_fatal (_("%s: cannot get addresses from archive"), file_name);
       bfd_close (abfd);
-      return 1;
+      return NULL;
     }
 
   if (! bfd_check_format_matches (abfd, bfd_object, &matching))
@@ -461,21 +553,37 @@ process_file (const char *file_name, const char *section_name,
       if (bfd_get_error () == bfd_error_file_ambiguously_recognized)
 	list_matching_formats (matching);
       bfd_close (abfd);
-      return 1;
+      return NULL;
     }
 
   if (section_name != NULL)
     {
-      section = bfd_get_section_by_name (abfd, section_name);
-      if (section == NULL)
+      *section = bfd_get_section_by_name (abfd, section_name);
+      if (*section == NULL)
 	{
 	  non_fatal (_("%s: cannot find section %s"), file_name, section_name);
 	  bfd_close (abfd);
-	  return 1;
+	  return NULL;
 	}
     }
   else
-    section = NULL;
+    *section = NULL;
+
+  return abfd;
+}
+
+/* Process a file.  Returns an exit value for main().  */
+
+static int
+process_file (const char *file_name, const char *section_name,
+	      const char *target)
+{
+  bfd *abfd;
+  asection *section;
+
+  abfd = open_file (file_name, section_name, target, &section);
+  if (abfd == NULL)
+    return 1;
 
   slurp_symtab (abfd);
 
@@ -488,7 +596,196 @@ process_file (const char *file_name, const char *section_name,
 
   return 0;
 }
-
+
+/* A file opened by the server mode.  Files are kept open, together
+   with their symbol tables and the debug information that BFD has
+   read, until the end of the input.  */
+
+struct server_file
+{
+  struct server_file *next;
+  char *name;
+  bfd *abfd;			/* NULL if the file could not be opened.  */
+  asection *section;
+  long symcount;
+  asymbol **syms;
+};
+
+static struct server_file *server_files;
+
+/* A BFD used only to format addresses that cannot be translated.  */
+static bfd *format_bfd;
+
+/* Return the server file for FILE_NAME, opening it if this is the first
+   request for it, and make its symbol table the current one.  */
+
+static struct server_file *
+select_server_file (const char *file_name, const char *section_name,
+		    const char *target)
+{
+  struct server_file *file;
+
+  for (file = server_files; file != NULL; file = file->next)
+    if (strcmp (file->name, file_name) == 0)
+      break;
+
+  if (file == NULL)
+    {
+      file = xmalloc (sizeof (*file));
+      file->name = xstrdup (file_name);
+      file->abfd = open_file (file_name, section_name, target,
+			      &file->section);
+      syms = NULL;
+      symcount = 0;
+      if (file->abfd != NULL)
+	slurp_symtab (file->abfd);
+      file->syms = syms;
+      file->symcount = symcount;
+      file->next = server_files;
+      server_files = file;
+    }
+
+  syms = file->syms;
+  symcount = file->symcount;
+  return file;
+}
+
+/* bfd_openr_iovec callbacks for FORMAT_BFD, which has no contents.  */
+
+static void *
+format_bfd_open (bfd *nbfd ATTRIBUTE_UNUSED, void *arg ATTRIBUTE_UNUSED)
+{
+  return &format_bfd;
+}
+
+static file_ptr
+format_bfd_pread (bfd *abfd ATTRIBUTE_UNUSED, void *stream ATTRIBUTE_UNUSED,
+		  void *buf ATTRIBUTE_UNUSED, file_ptr nbytes ATTRIBUTE_UNUSED,
+		  file_ptr offset ATTRIBUTE_UNUSED)
+{
+  return 0;
+}
+
+/* Print the address in REQUEST, which cannot be translated, with
+   --addresses.  It is printed as translate_pc would for a file of
+   TARGET, or of the default target.  */
+
+static void
+print_server_address (const char *request, const char *target)
+{
+  if (!with_addresses)
+    return;
+
+  if (format_bfd == NULL)
+    {
+      format_bfd = bfd_openr_iovec ("", target, format_bfd_open, NULL,
+				    format_bfd_pread, NULL, NULL);
+      if (format_bfd == NULL)
+	format_bfd = bfd_openr_iovec ("", NULL, format_bfd_open, NULL,
+				      format_bfd_pread, NULL, NULL);
+      if (format_bfd == NULL)
+	bfd_fatal (NULL);
+    }
+
+  printf ("0x");
+  bfd_printf_vma (format_bfd, bfd_scan_vma (request, NULL, 16));
+  if (pretty_print)
+    printf (": ");
+  else
+    printf ("\n");
+}
+
+/* Read requests from stdin until the end of the input.  A line of the
+   form "=FILE_NAME" selects the file used to translate the following
+   addresses; any other line is an address, which is translated as in
+   the normal mode.  Each file is only read once, however many times it
+   is selected.  FILE_NAME, if not NULL, is the initially selected file.
+   Returns an exit value for main().  */
+
+static int
+serve (const char *file_name, const char *section_name, const char *target)
+{
+  struct server_file *current = NULL;
+  char request[4096];
+  int status = 0;
+
+  if (file_name != NULL)
+    current = select_server_file (file_name, section_name, target);
+
+  while (fgets (request, sizeof request, stdin) != NULL)
+    {
+      char *end = request + strlen (request);
+      bool too_long = false;
+
+      /* Reject a request that does not fit in REQUEST, instead of
+	 reading it as several requests.  */
+      if (end > request && end[-1] != '\n')
+	{
+	  int c = getc (stdin);
+
+	  if (c != EOF && c != '\n')
+	    {
+	      too_long = true;
+	      while ((c = getc (stdin)) != EOF && c != '\n')
+		;
+	    }
+	}
+
+      while (end > request && ISSPACE (end[-1]))
+	*--end = '\0';
+
+      if (too_long)
+	non_fatal (_("request too long: %.40s..."), request);
+
+      if (request[0] == '=')
+	{
+	  if (too_long)
+	    current = NULL;
+	  else
+	    current = select_server_file (request + 1, section_name, target);
+	  if (current == NULL || current->abfd == NULL)
+	    status = 1;
+	  continue;
+	}
+
+      if (too_long || current == NULL || current->abfd == NULL)
+	{
+	  if (current == NULL && !too_long)
+	    non_fatal (_("no file selected for address %s"), request);
+	  print_server_address (request, target);
+	  print_unknown ();
+	}
+      else
+	{
+	  pc = parse_address (current->abfd, request);
+	  translate_pc (current->abfd, current->section);
+	}
+
+      /* As in translate_addresses, answer each request before reading
+	 the next one.  */
+      fflush (stdout);
+    }
+
+  while (server_files != NULL)
+    {
+      struct server_file *next = server_files->next;
+
+      free (server_files->syms);
+      if (server_files->abfd != NULL)
+	bfd_close (server_files->abfd);
+      free (server_files->name);
+      free (server_files);
+      server_files = next;
+    }
+  if (format_bfd != NULL)
+    bfd_close (format_bfd);
+  format_bfd = NULL;
+  syms = NULL;
+  symcount = 0;
+
+  return status;
+}
+
 int
 main (int argc, char **argv)
 {
@@ -556,6 +853,12 @@ main (int argc, char **argv)
 	case 's':
 	  base_names = true;
 	  break;
+	case OPTION_SORT_ADDRESSES:
+	  sort_addresses = true;
+	  break;
+	case OPTION_SERVER:
+	  server_mode = true;
+	  break;
 	case 'f':
 	  with_functions = true;
 	  break;
@@ -582,11 +885,20 @@ main (int argc, char **argv)
 	}
     }
 
-  if (file_name == NULL)
-    file_name = "a.out";
-
   addr = argv + optind;
   naddr = argc - optind;
 
+  if (server_mode)
+    {
+      if (naddr != 0)
+	fatal (_("addresses cannot be given on the command line with --server"));
+      if (sort_addresses)
+	fatal (_("--sort-addresses cannot be used with --server"));
+      return serve (file_name, section_name, target);
+    }
+
+  if (file_name == NULL)
+    file_name = "a.out";
+
   return process_file (file_name, section_name, target);
 }
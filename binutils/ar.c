@@ -139,6 +139,10 @@ static bool full_pathname = false;
 /* Whether to create a "thin" archive (symbol index only -- no files).  */
 static bool make_thin_archive = false;
 
+/* Whether to copy the index entries of the members which are not
+   changed from the old index, rather than reading their symbols.  */
+static int reuse_index = 0;
+
 #define LIBDEPS	"__.LIBDEP"
 /* Text to store in the __.LIBDEP archive element for the linker to use.  */
 static char * libdeps = NULL;
@@ -174,6 +178,7 @@ static struct option long_options[] =
   {"output", required_argument, NULL, OPTION_OUTPUT},
   {"record-libdeps", required_argument, NULL, 'l'},
   {"thin", no_argument, NULL, 'T'},
+  {"reuse-index", no_argument, &reuse_index, 1},
   {NULL, no_argument, NULL, 0}
 };
 
@@ -343,6 +348,7 @@ usage (int help)
   fprintf (s, _("  --output=DIRNAME - specify the output directory for extraction operations\n"));
   fprintf (s, _("  --record-libdeps=<text> - specify the dependencies of this library\n"));
   fprintf (s, _("  --thin       - make a thin archive\n"));
+  fprintf (s, _("  --reuse-index - keep the index entries of unchanged members\n"));
 #if BFD_SUPPORTS_PLUGINS
   fprintf (s, _(" optional:\n"));
   fprintf (s, _("  --plugin <p> - load the specified plugin\n"));
@@ -1308,6 +1314,9 @@ write_archive (bfd *iarch)
   if (full_pathname)
     obfd->flags |= BFD_ARCHIVE_FULL_PATH;
 
+  if (reuse_index)
+    obfd->flags |= BFD_ARCHIVE_REUSE_ARMAP;
+
   if (make_thin_archive || bfd_is_thin_archive (iarch))
     bfd_set_thin_archive (obfd, true);
 
@@ -76,6 +76,28 @@ extern void set_times (const char *, const struct stat *);
 extern int smart_rename (const char *, const char *, int,
 			 struct stat *, bool);
 
+/* In worker.c.  */
+#if defined (HAVE_FORK) && defined (HAVE_SYS_WAIT_H)
+#define HAVE_WORKER_PROCESSES 1
+
+/* A forked process doing part of the work of a tool.  */
+
+struct worker
+{
+  pid_t pid;
+  /* The worker's standard output and standard error.  */
+  FILE *out;
+  FILE *err;
+};
+
+extern pid_t start_worker (struct worker *);
+extern void finish_worker (int) ATTRIBUTE_NORETURN;
+extern int wait_for_worker (struct worker *);
+extern void copy_worker_output (FILE *, FILE *, off_t);
+extern void print_worker_output (struct worker *, bool);
+extern uint64_t worker_ranges (unsigned int, uint64_t, uint64_t);
+#endif
+
 #if __GNUC__ >= 7
 #define _mul_overflow(a, b, res) __builtin_mul_overflow (a, b, res)
 #else
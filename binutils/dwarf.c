@@ -117,6 +117,7 @@ bool do_checks;
 
 int dwarf_cutoff_level = -1;
 unsigned long dwarf_start_die;
+unsigned int dwarf_jobs = 1;
 
 int dwarf_check = 0;
 
@@ -3743,6 +3744,102 @@ read_bases (abbrev_entry *   entry,
     }
 }
 
+#ifdef HAVE_WORKER_PROCESSES
+/* Don't split .debug_info sections smaller than this between workers.  */
+#define DEBUG_INFO_JOB_MIN_SIZE (64 * 1024)
+
+/* The exit status of a worker which stopped displaying its units
+   because of a problem in the section.  */
+#define DEBUG_INFO_WORKER_STOPPED 2
+
+/* Start worker W, to display some of the units of a .debug_info
+   section.  Returns true in the worker, false in the parent.  */
+
+static bool
+start_debug_info_worker (struct worker *w)
+{
+  pid_t pid = start_worker (w);
+
+  if (pid < 0)
+    {
+      error (_("Unable to start a worker process: %s\n"), strerror (errno));
+      xexit (1);
+    }
+  return pid == 0;
+}
+
+/* Called by a worker when it has displayed its units.  OK is false if
+   it stopped early.  */
+
+static void
+finish_debug_info_worker (bool ok)
+{
+  finish_worker (ok ? 0 : DEBUG_INFO_WORKER_STOPPED);
+}
+
+/* Wait for worker W, and print its output unless DISCARD.  Returns
+   false if the worker did not display all of its units.  */
+
+static bool
+finish_debug_info_output (struct worker *w, bool discard)
+{
+  int status = wait_for_worker (w);
+  bool ok = true;
+
+  if (status != 0 && status != DEBUG_INFO_WORKER_STOPPED)
+    {
+      error (_("A worker process failed\n"));
+      ok = false;
+    }
+  else if (status != 0)
+    ok = false;
+
+  print_worker_output (w, discard);
+  return ok;
+}
+
+/* Display the units of a .debug_info section of SIZE bytes using
+   dwarf_jobs worker processes.  Returns false in the parent, once all
+   of the output has been printed, setting *OK to false if the display
+   stopped early.  Returns true in a worker, setting *PRINT_START and
+   *PRINT_STOP to the range of unit offsets that it should display.  */
+
+static bool
+display_units_in_workers (uint64_t size, uint64_t *print_start,
+			  uint64_t *print_stop, bool *ok)
+{
+  struct worker *workers;
+  uint64_t nchunks, chunk, i, next;
+
+  nchunks = worker_ranges (dwarf_jobs, size, DEBUG_INFO_JOB_MIN_SIZE);
+  chunk = size / nchunks;
+
+  workers = xcmalloc (nchunks, sizeof (*workers));
+  *ok = true;
+  next = 0;
+  for (i = 0; i < next || (*ok && i < nchunks); i++)
+    {
+      while (*ok && next < nchunks && next < i + dwarf_jobs)
+	{
+	  if (start_debug_info_worker (&workers[next]))
+	    {
+	      *print_start = next * chunk;
+	      *print_stop = next == nchunks - 1 ? size : (next + 1) * chunk;
+	      free (workers);
+	      return true;
+	    }
+	  next++;
+	}
+      /* Once a worker has stopped, the units after it are not shown.  */
+      if (!finish_debug_info_output (&workers[i], !*ok))
+	*ok = false;
+    }
+
+  free (workers);
+  return false;
+}
+#endif
+
 /* Process the contents of a .debug_info section.
    If do_loc is TRUE then we are scanning for location lists and dwo tags
    and we do not want to display anything to the user.
@@ -3765,6 +3862,11 @@ process_debug_info (struct dwarf_section * section,
   unsigned char *section_begin;
   unsigned int unit;
   unsigned int num_units = 0;
+  uint64_t print_start = 0;
+  uint64_t print_stop = (uint64_t) -1;
+#ifdef HAVE_WORKER_PROCESSES
+  bool in_worker = false;
+#endif
 
   /* First scan the section to get the number of comp units.
      Length sanity checks are done here.  */
@@ -3940,6 +4042,26 @@ process_debug_info (struct dwarf_section * section,
 	free_abbrev_list (free_list);
     }
 
+#ifdef HAVE_WORKER_PROCESSES
+  if (!do_loc && dwarf_jobs > 1 && dwarf_start_die == 0
+      && (size_t) (end - section_begin) >= 2 * DEBUG_INFO_JOB_MIN_SIZE)
+    {
+      bool ok;
+
+      in_worker = display_units_in_workers (end - section_begin,
+					    &print_start, &print_stop, &ok);
+      if (!in_worker)
+	{
+	  /* The workers' units were displayed but not recorded in
+	     debug_information, so leave num_debug_info_entries alone
+	     for load_debug_info to scan the section again if needed.  */
+	  if (ok)
+	    printf ("\n");
+	  return ok;
+	}
+    }
+#endif
+
   for (start = section_begin, unit = 0; start < end; unit++)
     {
       DWARF2_Internal_CompUnit compunit;
@@ -3987,6 +4109,15 @@ process_debug_info (struct dwarf_section * section,
 	  SAFE_BYTE_GET_AND_INC (compunit.cu_pointer_size, hdrptr, 1, end_cu);
 	}
 
+      /* A worker only displays the units starting in its range.  */
+      if (cu_offset < print_start)
+	{
+	  start = end_cu;
+	  continue;
+	}
+      if (cu_offset >= print_stop)
+	break;
+
       SAFE_BYTE_GET_AND_INC (compunit.cu_abbrev_offset, hdrptr, offset_size, end_cu);
 
       if (this_set == NULL)
@@ -4215,6 +4346,10 @@ process_debug_info (struct dwarf_section * section,
 		}
 	      warn (_("DIE at offset %#lx refers to abbreviation number %lu which does not exist\n"),
 		    die_offset, abbrev_number);
+#ifdef HAVE_WORKER_PROCESSES
+	      if (in_worker)
+		finish_debug_info_worker (false);
+#endif
 	      if (list != NULL)
 		free_abbrev_list (list);
 	      return false;
@@ -4339,6 +4474,11 @@ process_debug_info (struct dwarf_section * section,
 	free_abbrev_list (list);
     }
 
+#ifdef HAVE_WORKER_PROCESSES
+  if (in_worker)
+    finish_debug_info_worker (true);
+#endif
+
   /* Set num_debug_info_entries here so that it can be used to check if
      we need to process .debug_loc and .debug_ranges sections.  */
   if ((do_loc || do_debug_loc || do_debug_ranges || do_debug_info)
@@ -97,6 +97,7 @@ static bool verbose;		/* Print file and target names.  */
 static bool preserve_dates;	/* Preserve input file timestamp.  */
 static int deterministic = -1;		/* Enable deterministic archives.  */
 static int status = 0;			/* Exit status.  */
+static unsigned int copy_jobs = 1;	/* Number of files copied at once.  */
 
 static bool    merge_notes = false;	/* Merge note sections.  */
 static bool strip_section_headers = false;/* Strip section headers.  */
@@ -240,7 +241,8 @@ static enum
   compress_gnu_zlib = compress | 1 << 2,
   compress_gabi_zlib = compress | 1 << 3,
   compress_zstd = compress | 1 << 4,
-  decompress = 1 << 5
+  compress_zstd_seekable = compress | 1 << 5,
+  decompress = 1 << 6
 } do_debug_sections = nothing;
 
 /* Whether to generate ELF common symbols with the STT_COMMON type.  */
@@ -341,6 +343,7 @@ enum command_line_switch
   OPTION_IMAGE_BASE,
   OPTION_IMPURE,
   OPTION_INTERLEAVE_WIDTH,
+  OPTION_JOBS,
   OPTION_KEEPGLOBAL_SYMBOLS,
   OPTION_KEEP_FILE_SYMBOLS,
   OPTION_KEEP_SECTION,
@@ -400,6 +403,7 @@ static struct option strip_options[] =
   {"info", no_argument, 0, OPTION_FORMATS_INFO},
   {"input-format", required_argument, 0, 'I'}, /* Obsolete */
   {"input-target", required_argument, 0, 'I'},
+  {"jobs", required_argument, 0, OPTION_JOBS},
   {"keep-section-symbols", no_argument, 0, OPTION_KEEP_SECTION_SYMBOLS},
   {"keep-file-symbols", no_argument, 0, OPTION_KEEP_FILE_SYMBOLS},
   {"keep-section", required_argument, 0, OPTION_KEEP_SECTION},
@@ -473,6 +477,7 @@ static struct option copy_options[] =
   {"input-target", required_argument, 0, 'I'},
   {"interleave", optional_argument, 0, 'i'},
   {"interleave-width", required_argument, 0, OPTION_INTERLEAVE_WIDTH},
+  {"jobs", required_argument, 0, OPTION_JOBS},
   {"keep-file-symbols", no_argument, 0, OPTION_KEEP_FILE_SYMBOLS},
   {"keep-global-symbol", required_argument, 0, 'G'},
   {"keep-global-symbols", required_argument, 0, OPTION_KEEPGLOBAL_SYMBOLS},
@@ -698,9 +703,12 @@ copy_usage (FILE *stream, int exit_status)
                                    <commit>\n\
      --subsystem <name>[:<version>]\n\
                                    Set PE subsystem to <name> [& <version>]\n\
-     --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi|zstd}]\n\
+     --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi|zstd|zstd-seekable}]\n\
 				   Compress DWARF debug sections\n\
      --decompress-debug-sections   Decompress DWARF debug sections using zlib\n\
+     --jobs=<number>               Copy up to <number> archive members at once,\n\
+                                     and use up to <number> threads to compress\n\
+                                     each debug section with zstd\n\
      --elf-stt-common=[yes|no]     Generate ELF common symbols with STT_COMMON\n\
                                      type\n\
      --verilog-data-width <number> Specifies data width, in bytes, for verilog output\n\
@@ -766,6 +774,8 @@ strip_usage (FILE *stream, int exit_status)
   -h --help                        Display this output\n\
      --info                        List object formats & architectures supported\n\
   -o <file>                        Place stripped output into <file>\n\
+     --jobs=<number>               Strip up to <number> files or archive members\n\
+                                     at once\n\
 "));
 #if BFD_SUPPORTS_PLUGINS
   fprintf (stream, _("\
@@ -2738,7 +2748,7 @@ copy_object (bfd *ibfd, bfd *obfd, const bfd_arch_info_type *input_arch)
 	  && do_debug_sections != compress)
 	{
 	  non_fatal (_ ("--compress-debug-sections=[zlib|zlib-gnu|zlib-gabi|"
-			"zstd] is unsupported on `%s'"),
+			"zstd|zstd-seekable] is unsupported on `%s'"),
 		     bfd_get_archive_filename (ibfd));
 	  return false;
 	}
@@ -3613,28 +3623,214 @@ fail:
   return false;
 }
 
+#ifdef HAVE_WORKER_PROCESSES
+/* A process copying one input file or archive member.  */
+
+struct copy_worker
+{
+  struct worker w;
+  /* Which of change_sections the worker used.  */
+  FILE *used;
+};
+
+/* Start worker W.  Returns true in the worker, false in the parent.
+   IBFD, if not NULL, is an open BFD that the worker reads.  */
+
+static bool
+start_copy_worker (struct copy_worker *w, bfd *ibfd)
+{
+  /* Don't share the file, and so its position, with the worker.  Each
+     process opens it again when it next reads it.  */
+  if (ibfd != NULL)
+    bfd_cache_close (ibfd);
+
+  w->used = NULL;
+  if (change_sections != NULL)
+    {
+      w->used = tmpfile ();
+      if (w->used == NULL)
+	fatal (_("cannot create a temporary file for copying: %s"),
+	       strerror (errno));
+    }
+
+  switch (start_worker (&w->w))
+    {
+    case -1:
+      fatal (_("cannot start a copying worker: %s"), strerror (errno));
+    case 0:
+      break;
+    default:
+      return false;
+    }
+
+  /* The workers already keep the processors busy.  */
+  copy_jobs = 1;
+  bfd_set_compression_threads (1);
+  return true;
+}
+
+/* Called by worker W when it has finished, successfully if OK.  */
+
+static void
+finish_copy_worker (struct copy_worker *w, bool ok)
+{
+  struct section_list *p;
+
+  /* Tell the parent which section options were used, so that it can
+     warn about those that were not.  */
+  for (p = change_sections; p != NULL; p = p->next)
+    putc (p->used, w->used);
+  if (w->used != NULL)
+    fflush (w->used);
+  finish_worker (ok ? 0 : 1);
+}
+
+/* Wait for worker W and print its output.  Returns false if the
+   worker failed.  */
+
+static bool
+wait_for_copy_worker (struct copy_worker *w)
+{
+  struct section_list *p;
+  int wstatus = wait_for_worker (&w->w);
+
+  if (wstatus < 0)
+    non_fatal (_("copying worker failed"));
+  print_worker_output (&w->w, false);
+
+  if (w->used != NULL)
+    {
+      rewind (w->used);
+      for (p = change_sections; p != NULL; p = p->next)
+	if (getc (w->used) == 1)
+	  p->used = true;
+      fclose (w->used);
+    }
+
+  return wstatus == 0;
+}
+#endif
+
+/* A file created when copying an archive.  NAME is a temporary
+   directory if OBFD is NULL.  */
+
+struct name_list
+{
+  struct name_list *next;
+  char *name;
+  bfd *obfd;
+};
+
+/* Copy the archive member THIS_ELEMENT to a new file OUTPUT_NAME.
+   Returns false on failure, in which case the caller should remove
+   OUTPUT_NAME.  */
+
+static bool
+copy_archive_element (bfd *this_element, const char *output_name,
+		      const char *output_target, bool force_output_target,
+		      const bfd_arch_info_type *input_arch)
+{
+  bfd *output_element;
+  bool ok_object;
+  bool ok = true;
+
+  ok_object = bfd_check_format (this_element, bfd_object);
+  if (!ok_object)
+    bfd_nonfatal_message (NULL, this_element, NULL,
+			  _("Unable to recognise the format of file"));
+
+  /* PR binutils/3110: Cope with archives
+     containing multiple target types.  */
+  if (force_output_target || !ok_object)
+    output_element = bfd_openw (output_name, output_target);
+  else
+    output_element = bfd_openw (output_name, bfd_get_target (this_element));
+
+  if (output_element == NULL)
+    {
+      bfd_nonfatal_message (output_name, NULL, NULL, NULL);
+      return false;
+    }
+
+#if BFD_SUPPORTS_PLUGINS
+  /* Copy LTO IR file as unknown object.  */
+  if (bfd_plugin_target_p (this_element->xvec))
+    ok_object = false;
+  else
+#endif
+  if (ok_object)
+    {
+      ok = copy_object (this_element, output_element, input_arch);
+
+      if (!ok && bfd_get_arch (this_element) == bfd_arch_unknown)
+	/* Try again as an unknown object file.  */
+	ok_object = false;
+    }
+
+  if (!ok_object)
+    ok = copy_unknown_object (this_element, output_element);
+
+  if (!(ok_object && ok
+	? bfd_close : bfd_close_all_done) (output_element))
+    {
+      bfd_nonfatal_message (output_name, NULL, NULL, NULL);
+      /* Error in new object file.  Don't change archive.  */
+      ok = false;
+    }
+
+  return ok;
+}
+
+/* Add the copied archive member recorded in L to the archive at *PTR
+   if OK, and otherwise remove it.  Returns OK.  */
+
+static bool
+add_archive_element (struct name_list *l, const char *output_target,
+		     bfd ***ptr, bool ok)
+{
+  if (!ok)
+    {
+      unlink (l->name);
+      free (l->name);
+      l->name = NULL;
+      return false;
+    }
+
+  /* Open the newly created output file and attach to our list.  */
+  l->obfd = bfd_openr (l->name, output_target);
+
+  **ptr = l->obfd;
+  *ptr = &l->obfd->archive_next;
+  return true;
+}
+
 /* Read each archive element in turn from IBFD, copy the
    contents to temp file, and keep the temp file handle.
    If 'force_output_target' is TRUE then make sure that
    all elements in the new archive are of the type
-   'output_target'.  */
+   'output_target'.  If COPY_JOBS is more than one, up to
+   that many elements are copied at once by worker processes.  */
 
 static bool
 copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
 	      bool force_output_target,
 	      const bfd_arch_info_type *input_arch)
 {
-  struct name_list
-    {
-      struct name_list *next;
-      char *name;
-      bfd *obfd;
-    } *list;
+  struct name_list *list;
   bfd **ptr = &obfd->archive_head;
   bfd *this_element;
   char *dir = NULL;
   char *filename;
   bool ok = true;
+#ifdef HAVE_WORKER_PROCESSES
+  struct archive_worker
+    {
+      struct copy_worker w;
+      struct name_list *l;
+    } *workers = NULL;
+  unsigned int first = 0;
+  unsigned int nworkers = 0;
+#endif
 
   list = NULL;
 
@@ -3683,13 +3879,16 @@ copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
       goto cleanup_and_exit;
     }
 
+#ifdef HAVE_WORKER_PROCESSES
+  if (copy_jobs > 1)
+    workers = xmalloc (copy_jobs * sizeof (*workers));
+#endif
+
   while (ok && this_element != NULL)
     {
       char *output_name;
-      bfd *output_element;
       struct stat buf;
       int stat_status = 0;
-      bool ok_object;
       const char *element_name;
 
       element_name = bfd_get_filename (this_element);
@@ -3748,57 +3947,58 @@ copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
       l->obfd = NULL;
       list = l;
 
-      ok_object = bfd_check_format (this_element, bfd_object);
-      if (!ok_object)
-	bfd_nonfatal_message (NULL, this_element, NULL,
-			      _("Unable to recognise the format of file"));
-
-      /* PR binutils/3110: Cope with archives
-	 containing multiple target types.  */
-      if (force_output_target || !ok_object)
-	output_element = bfd_openw (output_name, output_target);
-      else
-	output_element = bfd_openw (output_name, bfd_get_target (this_element));
-
-      if (output_element == NULL)
+#ifdef HAVE_WORKER_PROCESSES
+      if (workers != NULL)
 	{
-	  bfd_nonfatal_message (output_name, NULL, NULL, NULL);
-	  bfd_close (this_element);
-	  ok = false;
-	  goto cleanup_and_exit;
-	}
+	  struct archive_worker *aw;
+	  FILE *f;
 
-#if BFD_SUPPORTS_PLUGINS
-      /* Copy LTO IR file as unknown object.  */
-      if (bfd_plugin_target_p (this_element->xvec))
-	ok_object = false;
-      else
-#endif
-      if (ok_object)
-	{
-	  ok = copy_object (this_element, output_element, input_arch);
+	  /* Create the file now, so that the check above finds it if a
+	     later member has the same name.  */
+	  f = fopen (output_name, FOPEN_WB);
+	  if (f != NULL)
+	    fclose (f);
 
-	  if (!ok && bfd_get_arch (this_element) == bfd_arch_unknown)
-	    /* Try again as an unknown object file.  */
-	    ok_object = false;
-	}
+	  if (nworkers == copy_jobs)
+	    {
+	      aw = &workers[first];
+	      ok = add_archive_element (aw->l, output_target, &ptr,
+					wait_for_copy_worker (&aw->w));
+	      first = (first + 1) % copy_jobs;
+	      nworkers--;
+	      if (!ok)
+		{
+		  add_archive_element (l, output_target, &ptr, false);
+		  bfd_close (this_element);
+		  break;
+		}
+	    }
 
-      if (!ok_object)
-	ok = copy_unknown_object (this_element, output_element);
+	  aw = &workers[(first + nworkers) % copy_jobs];
+	  aw->l = l;
+	  if (start_copy_worker (&aw->w, ibfd))
+	    {
+	      ok = copy_archive_element (this_element, output_name,
+					 output_target, force_output_target,
+					 input_arch);
+	      if (ok && preserve_dates && stat_status == 0)
+		set_times (output_name, &buf);
+	      finish_copy_worker (&aw->w, ok);
+	    }
+	  nworkers++;
 
-      if (!(ok_object && ok
-	    ? bfd_close : bfd_close_all_done) (output_element))
-	{
-	  bfd_nonfatal_message (output_name, NULL, NULL, NULL);
-	  /* Error in new object file.  Don't change archive.  */
-	  ok = false;
+	  bfd *last_element = this_element;
+	  this_element = bfd_openr_next_archived_file (ibfd, last_element);
+	  bfd_close (last_element);
+	  continue;
 	}
+#endif
 
+      ok = copy_archive_element (this_element, output_name, output_target,
+				 force_output_target, input_arch);
       if (!ok)
 	{
-	  unlink (output_name);
-	  free (output_name);
-	  list->name = NULL;
+	  add_archive_element (l, output_target, &ptr, false);
 	  bfd_close (this_element);
 	}
       else
@@ -3806,22 +4006,30 @@ copy_archive (bfd *ibfd, bfd *obfd, const char *output_target,
 	  if (preserve_dates && stat_status == 0)
 	    set_times (output_name, &buf);
 
-	  /* Open the newly created output file and attach to our list.  */
-	  output_element = bfd_openr (output_name, output_target);
-
-	  list->obfd = output_element;
-
-	  *ptr = output_element;
-	  ptr = &output_element->archive_next;
+	  add_archive_element (l, output_target, &ptr, true);
 
 	  bfd *last_element = this_element;
 	  this_element = bfd_openr_next_archived_file (ibfd, last_element);
 	  bfd_close (last_element);
 	}
     }
-  *ptr = NULL;
 
  cleanup_and_exit:
+#ifdef HAVE_WORKER_PROCESSES
+  /* Wait for the members still being copied, adding them to the archive
+     in order unless something failed.  */
+  for (; nworkers > 0; nworkers--)
+    {
+      struct archive_worker *aw = &workers[first];
+
+      ok = add_archive_element (aw->l, output_target, &ptr,
+				wait_for_copy_worker (&aw->w) && ok);
+      first = (first + 1) % copy_jobs;
+    }
+  free (workers);
+#endif
+  *ptr = NULL;
+
   filename = xstrdup (bfd_get_filename (obfd));
   if (!(ok ? bfd_close : bfd_close_all_done) (obfd))
     {
@@ -3924,6 +4132,14 @@ copy_file (const char *input_filename, const char *output_filename, int ofd,
 #ifndef HAVE_ZSTD
       fatal (_ ("--compress-debug-sections=zstd: binutils is not built with "
 		"zstd support"));
+#endif
+      break;
+    case compress_zstd_seekable:
+      ibfd->flags |= (BFD_COMPRESS | BFD_COMPRESS_GABI | BFD_COMPRESS_ZSTD
+		      | BFD_COMPRESS_ZSTD_SEEKABLE);
+#ifndef HAVE_ZSTD
+      fatal (_ ("--compress-debug-sections=zstd-seekable: binutils is not "
+		"built with zstd support"));
 #endif
       break;
     case decompress:
@@ -4883,6 +5099,64 @@ default_deterministic (void)
     deterministic = DEFAULT_AR_DETERMINISTIC;
 }
 
+/* Strip FILE, writing the result to OUTPUT_FILE if that is not NULL,
+   and otherwise replacing FILE.  */
+
+static void
+strip_file (const char *file, char *output_file, const char *input_target,
+	    const char *output_target)
+{
+  int hold_status = status;
+  struct stat statbuf;
+  char *tmpname;
+  int tmpfd = -1;
+  int copyfd = -1;
+
+  if (get_file_size (file) < 1)
+    {
+      status = 1;
+      return;
+    }
+
+  if (output_file == NULL
+      || filename_cmp (file, output_file) == 0)
+    {
+      tmpname = make_tempname (file, &tmpfd);
+      if (tmpfd >= 0)
+	copyfd = dup (tmpfd);
+    }
+  else
+    tmpname = output_file;
+
+  if (tmpname == NULL)
+    {
+      bfd_nonfatal_message (file, NULL, NULL,
+			    _("could not create temporary file to hold stripped copy"));
+      status = 1;
+      return;
+    }
+
+  status = 0;
+  copy_file (file, tmpname, tmpfd, &statbuf, input_target,
+	     output_target, NULL);
+  if (status == 0)
+    {
+      const char *oname = output_file ? output_file : file;
+      status = smart_rename (tmpname, oname, copyfd,
+			     &statbuf, preserve_dates) != 0;
+      if (status == 0)
+	status = hold_status;
+    }
+  else
+    {
+      if (copyfd >= 0)
+	close (copyfd);
+      unlink_if_ordinary (tmpname);
+    }
+  if (output_file != tmpname)
+    free (tmpname);
+}
+
 static int
 strip_main (int argc, char *argv[])
 {
@@ -4989,6 +5263,18 @@ strip_main (int argc, char *argv[])
 	case OPTION_KEEP_SECTION_SYMBOLS:
 	  keep_section_symbols = true;
 	  break;
+	case OPTION_JOBS:
+	  {
+	    char *end;
+	    unsigned long jobs = strtoul (optarg, &end, 0);
+
+	    if (*end != '\0')
+	      fatal (_("error: invalid number of jobs: %s"), optarg);
+	    if (jobs == 0 || jobs > UINT_MAX)
+	      fatal (_("error: the number of jobs must be at least 1"));
+	    copy_jobs = jobs;
+	  }
+	  break;
 	case OPTION_PLUGIN:	/* --plugin */
 #if BFD_SUPPORTS_PLUGINS
 	  bfd_plugin_set_plugin (optarg);
@@ -5053,58 +5339,49 @@ strip_main (int argc, char *argv[])
       || (output_file != NULL && (i + 1) < argc))
     strip_usage (stderr, 1);
 
-  for (; i < argc; i++)
+#ifdef HAVE_WORKER_PROCESSES
+  if (copy_jobs > 1 && argc - i > 1)
     {
-      int hold_status = status;
-      struct stat statbuf;
-      char *tmpname;
-      int tmpfd = -1;
-      int copyfd = -1;
+      struct copy_worker *workers;
+      unsigned int first = 0;
+      unsigned int nworkers = 0;
 
-      if (get_file_size (argv[i]) < 1)
+      workers = xmalloc (copy_jobs * sizeof (*workers));
+      for (; i < argc; i++)
 	{
-	  status = 1;
-	  continue;
-	}
+	  struct copy_worker *w;
 
-      if (output_file == NULL
-	  || filename_cmp (argv[i], output_file) == 0)
-	{
-	  tmpname = make_tempname (argv[i], &tmpfd);
-	  if (tmpfd >= 0)
-	    copyfd = dup (tmpfd);
-	}
-      else
-	tmpname = output_file;
+	  if (nworkers == copy_jobs)
+	    {
+	      if (!wait_for_copy_worker (&workers[first]))
+		status = 1;
+	      first = (first + 1) % copy_jobs;
+	      nworkers--;
+	    }
 
-      if (tmpname == NULL)
-	{
-	  bfd_nonfatal_message (argv[i], NULL, NULL,
-				_("could not create temporary file to hold stripped copy"));
-	  status = 1;
-	  continue;
+	  w = &workers[(first + nworkers) % copy_jobs];
+	  if (start_copy_worker (w, NULL))
+	    {
+	      status = 0;
+	      strip_file (argv[i], output_file, input_target, output_target);
+	      finish_copy_worker (w, status == 0);
+	    }
+	  nworkers++;
 	}
 
-      status = 0;
-      copy_file (argv[i], tmpname, tmpfd, &statbuf, input_target,
-		 output_target, NULL);
-      if (status == 0)
+      for (; nworkers > 0; nworkers--)
 	{
-	  const char *oname = output_file ? output_file : argv[i];
-	  status = smart_rename (tmpname, oname, copyfd,
-				 &statbuf, preserve_dates) != 0;
-	  if (status == 0)
-	    status = hold_status;
-	}
-      else
-	{
-	  if (copyfd >= 0)
-	    close (copyfd);
-	  unlink_if_ordinary (tmpname);
+	  if (!wait_for_copy_worker (&workers[first]))
+	    status = 1;
+	  first = (first + 1) % copy_jobs;
 	}
-      if (output_file != tmpname)
-	free (tmpname);
+      free (workers);
+      return status;
     }
+#endif
+
+  for (; i < argc; i++)
+    strip_file (argv[i], output_file, input_target, output_target);
 
   return status;
 }
@@ -5383,6 +5660,20 @@ copy_main (int argc, char *argv[])
 	    fatal(_("interleave width must be positive"));
 	  break;
 
+	case OPTION_JOBS:
+	  {
+	    char *end;
+	    unsigned long jobs = strtoul (optarg, &end, 0);
+
+	    if (*end != '\0')
+	      fatal (_("error: invalid number of jobs: %s"), optarg);
+	    if (jobs == 0 || jobs > UINT_MAX)
+	      fatal (_("error: the number of jobs must be at least 1"));
+	    copy_jobs = jobs;
+	    bfd_set_compression_threads (jobs);
+	  }
+	  break;
+
 	case 'I':
 	case 's':		/* "source" - 'I' is preferred */
 	  input_target = optarg;
@@ -5703,6 +5994,8 @@ copy_main (int argc, char *argv[])
 		do_debug_sections = compress_gabi_zlib;
 	      else if (strcasecmp (optarg, "zstd") == 0)
 		do_debug_sections = compress_zstd;
+	      else if (strcasecmp (optarg, "zstd-seekable") == 0)
+		do_debug_sections = compress_zstd_seekable;
 	      else
 		fatal (_("unrecognized --compress-debug-sections type `%s'"),
 		       optarg);
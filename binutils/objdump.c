@@ -119,6 +119,7 @@ static bool formats_info;		/* -i */
 int wide_output;			/* -w */
 #define MAX_INSN_WIDTH 49
 static unsigned long insn_width;	/* --insn-width */
+static unsigned int disassemble_jobs = 1; /* --jobs */
 static bfd_vma start_address = (bfd_vma) -1; /* --start-address */
 static bfd_vma stop_address = (bfd_vma) -1;  /* --stop-address */
 static int dump_debugging;		/* --debugging */
@@ -407,6 +408,9 @@ usage (FILE *stream, int status)
       fprintf (stream, _("\
       --insn-width=WIDTH         Display WIDTH bytes on a single line for -d\n"));
       fprintf (stream, _("\
+      --jobs=N                   Disassemble large sections, and display large\n\
+                                 .debug_info sections, using N processes\n"));
+      fprintf (stream, _("\
       --adjust-vma=OFFSET        Add OFFSET to all displayed section addresses\n"));
       fprintf (stream, _("\
       --show-all-symbols         When disassembling, display all symbols at a given address\n"));
@@ -481,6 +485,7 @@ enum option_values
     OPTION_PREFIX,
     OPTION_PREFIX_STRIP,
     OPTION_INSN_WIDTH,
+    OPTION_JOBS,
     OPTION_ADJUST_VMA,
     OPTION_DWARF_DEPTH,
     OPTION_DWARF_CHECK,
@@ -535,6 +540,7 @@ static struct option long_options[]=
   {"info", no_argument, NULL, 'i'},
   {"inlines", no_argument, 0, OPTION_INLINES},
   {"insn-width", required_argument, NULL, OPTION_INSN_WIDTH},
+  {"jobs", required_argument, NULL, OPTION_JOBS},
   {"line-numbers", no_argument, NULL, 'l'},
   {"no-addresses", no_argument, &no_addresses, 1},
   {"no-recurse-limit", no_argument, NULL, OPTION_NO_RECURSE_LIMIT},
@@ -1385,6 +1391,25 @@ sym_ok (bool want_section,
   return inf->symbol_is_valid (sorted_syms[place], inf);
 }
 
+/* The positions in sorted_syms found by the last lookups of
+   find_symbol_for_address, most recently used first.  The disassembler
+   looks up addresses in increasing order, interleaved with the
+   addresses used by the instructions, so a few cursors that move
+   forward with the lookups let most of them skip the binary search.  */
+static long sym_lookup_cursor[8];
+
+/* Return true if PLACE is the last position in sorted_syms of a symbol
+   whose value is at most VMA.  */
+
+static bool
+last_sym_at_or_below_p (long place, bfd_vma vma)
+{
+  return (place < sorted_symcount
+	  && bfd_asymbol_value (sorted_syms[place]) <= vma
+	  && (place + 1 == sorted_symcount
+	      || bfd_asymbol_value (sorted_syms[place + 1]) > vma));
+}
+
 /* Locate a symbol given a bfd and a section (from INFO->application_data),
    and a VMA.  If INFO->application_data->require_sec is TRUE, then always
    require the symbol to be in the section.  Returns NULL if there is no
@@ -1396,15 +1421,11 @@ find_symbol_for_address (bfd_vma vma,
 			 struct disassemble_info *inf,
 			 long *place)
 {
-  /* @@ Would it speed things up to cache the last two symbols returned,
-     and maybe their address ranges?  For many processors, only one memory
-     operand can be present at a time, so the 2-entry cache wouldn't be
-     constantly churned by code doing heavy memory accesses.  */
-
   /* Indices in `sorted_syms'.  */
   long min = 0;
   long max_count = sorted_symcount;
   long thisplace;
+  unsigned int c;
   struct objdump_disasm_info *aux;
   bfd *abfd;
   asection *sec;
@@ -1420,26 +1441,50 @@ find_symbol_for_address (bfd_vma vma,
   sec = inf->section;
   opb = inf->octets_per_byte;
 
+  /* Try the positions found by the last searches, and the positions
+     just after them, before searching.  */
+  for (c = 0; c < ARRAY_SIZE (sym_lookup_cursor); c++)
+    {
+      thisplace = sym_lookup_cursor[c];
+      if (last_sym_at_or_below_p (thisplace, vma)
+	  || last_sym_at_or_below_p (++thisplace, vma))
+	{
+	  min = thisplace;
+	  break;
+	}
+    }
+
   /* Perform a binary search looking for the closest symbol to the
      required value.  We are searching the range (min, max_count].  */
-  while (min + 1 < max_count)
+  if (c == ARRAY_SIZE (sym_lookup_cursor))
     {
-      asymbol *sym;
+      while (min + 1 < max_count)
+	{
+	  asymbol *sym;
 
-      thisplace = (max_count + min) / 2;
-      sym = sorted_syms[thisplace];
+	  thisplace = (max_count + min) / 2;
+	  sym = sorted_syms[thisplace];
 
-      if (bfd_asymbol_value (sym) > vma)
-	max_count = thisplace;
-      else if (bfd_asymbol_value (sym) < vma)
-	min = thisplace;
-      else
-	{
-	  min = thisplace;
-	  break;
+	  if (bfd_asymbol_value (sym) > vma)
+	    max_count = thisplace;
+	  else if (bfd_asymbol_value (sym) < vma)
+	    min = thisplace;
+	  else
+	    {
+	      min = thisplace;
+	      break;
+	    }
 	}
+
+      c = ARRAY_SIZE (sym_lookup_cursor) - 1;
     }
 
+  /* Move the cursor to the front, dropping the least recently used
+     one if the search was not avoided.  */
+  memmove (&sym_lookup_cursor[1], &sym_lookup_cursor[0],
+	   c * sizeof (sym_lookup_cursor[0]));
+  sym_lookup_cursor[0] = min;
+
   /* The symbol we want is now in min, the low end of the range we
      were searching.  If there are several symbols with the same
      value, we want the first one.  */
@@ -2189,6 +2234,45 @@ dump_lines (struct print_file_list *p, unsigned int start, unsigned int end)
     }
 }
 
+#ifdef HAVE_WORKER_PROCESSES
+/* With --jobs, a large section is split into ranges that are
+   disassembled by worker processes, each writing its output to a
+   temporary file.  What show_line prints depends on everything that
+   was shown before, so instead of calling it a worker records the
+   position in its output where it would have been called, and the
+   parent calls it while copying the workers' output to stdout in
+   order.  The first record of a worker gives the position of the
+   start of its range in its output.  */
+
+struct deferred_line
+{
+  off_t pos;
+  bfd_vma addr_offset;
+};
+
+/* In a worker process, the file of deferred show_line calls.  NULL in
+   the parent.  */
+static FILE *deferred_lines;
+
+/* Record a show_line call for ADDR_OFFSET at the current position in
+   the output of a worker.  */
+
+static void
+defer_show_line (bfd_vma addr_offset)
+{
+  struct deferred_line rec;
+
+  fflush (stdout);
+  rec.pos = lseek (STDOUT_FILENO, 0, SEEK_CUR);
+  rec.addr_offset = addr_offset;
+  if (fwrite (&rec, sizeof (rec), 1, deferred_lines) != 1)
+    {
+      non_fatal (_("cannot write disassembly worker data"));
+      _exit (1);
+    }
+}
+#endif
+
 /* Show the line number, or the source line, in a disassembly
    listing.  */
 
@@ -2205,6 +2289,14 @@ show_line (bfd *abfd, asection *section, bfd_vma addr_offset)
   if (! with_line_numbers && ! with_source_code)
     return;
 
+#ifdef HAVE_WORKER_PROCESSES
+  if (deferred_lines != NULL)
+    {
+      defer_show_line (addr_offset);
+      return;
+    }
+#endif
+
 #ifdef HAVE_LIBDEBUGINFOD
   {
     bfd *debug_bfd;
@@ -3752,6 +3844,134 @@ disassemble_bytes (struct disassemble_info *inf,
   free (color_buffer);
 }
 
+#ifdef HAVE_WORKER_PROCESSES
+/* Don't split sections smaller than this between workers.  */
+#define DISASSEMBLE_JOB_MIN_SIZE (16 * 1024)
+
+/* A process disassembling part of a section.  LINES holds the
+   deferred_line records of the worker's calls to show_line.  */
+
+struct disasm_worker
+{
+  struct worker w;
+  FILE *lines;
+};
+
+/* Start worker W.  Returns true in the worker, false in the parent.  */
+
+static bool
+start_disasm_worker (struct disasm_worker *w)
+{
+  pid_t pid;
+
+  w->lines = tmpfile ();
+  if (w->lines == NULL)
+    fatal (_("cannot create a temporary file for disassembly: %s"),
+	   strerror (errno));
+
+  pid = start_worker (&w->w);
+  if (pid < 0)
+    fatal (_("cannot start a disassembly worker: %s"), strerror (errno));
+  if (pid != 0)
+    return false;
+
+  deferred_lines = w->lines;
+  return true;
+}
+
+/* Called by a worker when its range has been disassembled.  STARTED
+   is false if no output was printed for the range.  */
+
+static void
+finish_disasm_worker (bool started)
+{
+  if (!started)
+    defer_show_line (0);
+  fflush (deferred_lines);
+  finish_worker (exit_status);
+}
+
+/* Wait for worker W, and print its output, disassembling SECTION of
+   ABFD, on stdout.  */
+
+static void
+finish_disasm_output (struct disasm_worker *w, bfd *abfd, asection *section)
+{
+  struct deferred_line rec;
+  int status;
+  off_t pos;
+  bool discard = true;
+
+  status = wait_for_worker (&w->w);
+  if (status < 0)
+    {
+      non_fatal (_("disassembly worker for section %s failed"),
+		 sanitize_string (section->name));
+      exit_status = 1;
+    }
+  else if (status != 0)
+    exit_status = 1;
+
+  rewind (w->lines);
+  if (fread (&rec, sizeof (rec), 1, w->lines) == 1)
+    {
+      /* Skip the symbols printed before the start of the range.  */
+      copy_worker_output (w->w.out, NULL, rec.pos);
+      pos = rec.pos;
+      while (fread (&rec, sizeof (rec), 1, w->lines) == 1)
+	{
+	  copy_worker_output (w->w.out, stdout, rec.pos - pos);
+	  pos = rec.pos;
+	  show_line (abfd, section, rec.addr_offset);
+	}
+      discard = false;
+    }
+
+  print_worker_output (&w->w, discard);
+  fclose (w->lines);
+}
+
+/* Disassemble the range [ADDR_OFFSET, STOP_OFFSET) of SECTION of ABFD
+   using worker processes.  Returns false in the parent, once all of the
+   output has been printed.  Returns true in a worker, setting
+   *PRINT_START and *PRINT_STOP to the range that it should print.  */
+
+static bool
+disassemble_in_workers (bfd *abfd, asection *section,
+			bfd_vma addr_offset, bfd_vma stop_offset,
+			bfd_vma *print_start, bfd_vma *print_stop)
+{
+  struct disasm_worker *workers;
+  bfd_vma size = stop_offset - addr_offset;
+  bfd_vma nchunks, chunk, i, next;
+
+  nchunks = worker_ranges (disassemble_jobs, size, DISASSEMBLE_JOB_MIN_SIZE);
+  chunk = size / nchunks;
+
+  workers = xcalloc (nchunks, sizeof (*workers));
+  next = 0;
+  for (i = 0; i < nchunks; i++)
+    {
+      while (next < nchunks && next < i + disassemble_jobs)
+	{
+	  if (start_disasm_worker (&workers[next]))
+	    {
+	      *print_start = addr_offset + next * chunk;
+	      *print_stop = (next == nchunks - 1
+			     ? stop_offset : addr_offset + (next + 1) * chunk);
+	      free (workers);
+	      return true;
+	    }
+	  next++;
+	}
+      finish_disasm_output (&workers[i], abfd, section);
+    }
+
+  free (workers);
+  return false;
+}
+#endif
+
 static void
 disassemble_section (bfd *abfd, asection *section, void *inf)
 {
@@ -3771,6 +3991,10 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
   long rel_count;
   bfd_vma rel_offset;
   unsigned long addr_offset;
+  bfd_vma print_start;
+  bfd_vma print_stop;
+  bool started;
+  bool in_worker = false;
   bool do_print;
   enum loop_control
   {
@@ -3906,13 +4130,41 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
   do_print = paux->symbol_list == NULL;
   loop_until = stop_offset_reached;
 
-  while (addr_offset < stop_offset)
+  /* Only the blocks starting in [PRINT_START, PRINT_STOP) are printed.
+     A worker still walks the symbols from the start of the section, so
+     that its state is the same as if the whole section had been
+     disassembled, but skips the disassembly before its range.  */
+  print_start = addr_offset;
+  print_stop = stop_offset;
+#ifdef HAVE_WORKER_PROCESSES
+  if (disassemble_jobs > 1
+      && paux->symbol_list == NULL
+      && stop_offset - addr_offset >= 2 * DISASSEMBLE_JOB_MIN_SIZE)
+    {
+      in_worker = disassemble_in_workers (abfd, section, addr_offset,
+					  stop_offset, &print_start,
+					  &print_stop);
+      if (!in_worker)
+	print_stop = addr_offset;
+    }
+#endif
+  started = !in_worker;
+
+  while (addr_offset < stop_offset && addr_offset < print_stop)
     {
       bfd_vma addr;
       asymbol *nextsym;
       bfd_vma nextstop_offset;
       bool insns;
 
+#ifdef HAVE_WORKER_PROCESSES
+      if (!started && addr_offset >= print_start)
+	{
+	  defer_show_line (0);
+	  started = true;
+	}
+#endif
+
       /* Skip over the relocs belonging to addresses below the
 	 start address.  */
       while (rel_pp < rel_ppend
@@ -4102,7 +4354,7 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
       else
 	insns = false;
 
-      if (do_print)
+      if (do_print && started)
 	{
 	  /* Resolve symbol name.  */
 	  if (visualize_jumps && abfd && sym && sym->name)
@@ -4143,6 +4395,11 @@ disassemble_section (bfd *abfd, asection *section, void *inf)
       sym = nextsym;
     }
 
+#ifdef HAVE_WORKER_PROCESSES
+  if (in_worker)
+    finish_disasm_worker (started);
+#endif
+
   free (data);
   free (rel_ppstart);
 }
@@ -5096,6 +5353,7 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 {
   bfd_byte *data = NULL;
   bfd_size_type datasize;
+  bfd_size_type data_start;
   bfd_vma addr_offset;
   bfd_vma start_offset;
   bfd_vma stop_offset;
@@ -5149,11 +5407,30 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
   if (bfd_is_section_compressed (abfd, section) && ! decompressed_dumps)
     printf (_(" NOTE: This section is compressed, but its contents have NOT been expanded for this dump.\n"));
 
-  if (!bfd_get_full_section_contents (abfd, section, &data))
+  /* Read only the range to display, so that dumping a small part of a
+     large compressed section does not decompress all of it.  */
+  if (start_offset == 0 && stop_offset == datasize / opb)
     {
-      non_fatal (_("Reading section %s failed because: %s"),
-		 section->name, bfd_errmsg (bfd_get_error ()));
-      return;
+      data_start = 0;
+      if (!bfd_get_full_section_contents (abfd, section, &data))
+	{
+	  non_fatal (_("Reading section %s failed because: %s"),
+		     section->name, bfd_errmsg (bfd_get_error ()));
+	  return;
+	}
+    }
+  else
+    {
+      data_start = start_offset * opb;
+      data = (bfd_byte *) xmalloc ((stop_offset - start_offset) * opb);
+      if (!bfd_get_section_contents (abfd, section, data, data_start,
+				     (stop_offset - start_offset) * opb))
+	{
+	  non_fatal (_("Reading section %s failed because: %s"),
+		     section->name, bfd_errmsg (bfd_get_error ()));
+	  free (data);
+	  return;
+	}
     }
 
   width = 4;
@@ -5203,7 +5480,7 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 	   j < addr_offset * opb + onaline; j++)
 	{
 	  if (j < stop_offset * opb)
-	    printf ("%02x", (unsigned) (data[j]));
+	    printf ("%02x", (unsigned) (data[j - data_start]));
 	  else
 	    printf ("  ");
 	  if ((j & 3) == 3)
@@ -5217,7 +5494,8 @@ dump_section (bfd *abfd, asection *section, void *dummy ATTRIBUTE_UNUSED)
 	  if (j >= stop_offset * opb)
 	    printf (" ");
 	  else
-	    printf ("%c", ISPRINT (data[j]) ? data[j] : '.');
+	    printf ("%c", (ISPRINT (data[j - data_start])
+			   ? data[j - data_start] : '.'));
 	}
       putchar ('\n');
     }
@@ -6142,6 +6420,19 @@ main (int argc, char **argv)
 	    fatal (_("error: instruction width must be in the range 1 to "
 		     XSTRING (MAX_INSN_WIDTH)));
 	  break;
+	case OPTION_JOBS:
+	  {
+	    char *cp;
+	    unsigned long jobs = strtoul (optarg, &cp, 0);
+
+	    if (*cp != '\0' || jobs > UINT_MAX)
+	      fatal (_("error: invalid number of jobs: %s"), optarg);
+	    if (jobs == 0)
+	      fatal (_("error: the number of jobs must be at least 1"));
+	    disassemble_jobs = jobs;
+	    dwarf_jobs = jobs;
+	  }
+	  break;
 	case OPTION_INLINES:
 	  unwind_inlines = true;
 	  break;
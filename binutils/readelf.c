@@ -53,6 +53,10 @@
 #include <msgpack.h>
 #endif
 
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 /* Define BFD64 here, even if our default architecture is 32 bit ELF
    as this will allow us to read in and parse 64bit and 32bit ELF files.  */
 #define BFD64
@@ -6094,7 +6098,8 @@ enum long_option_values
   OPTION_NO_RECURSE_LIMIT,
   OPTION_NO_DEMANGLING,
   OPTION_NO_EXTRA_SYM_INFO,
-  OPTION_SYM_BASE
+  OPTION_SYM_BASE,
+  OPTION_JOBS
 };
 
 static struct option options[] =
@@ -6149,6 +6154,7 @@ static struct option options[] =
   {"dwarf-depth",      required_argument, 0, OPTION_DWARF_DEPTH},
   {"dwarf-start",      required_argument, 0, OPTION_DWARF_START},
   {"dwarf-check",      no_argument, 0, OPTION_DWARF_CHECK},
+  {"jobs",	       required_argument, 0, OPTION_JOBS},
 #ifdef ENABLE_LIBCTF
   {"ctf",	       required_argument, 0, OPTION_CTF_DUMP},
   {"ctf-symbols",      required_argument, 0, OPTION_CTF_SYMBOLS},
@@ -6291,6 +6297,8 @@ usage (FILE * stream)
   --dwarf-depth=N        Do not display DIEs at depth N or greater\n"));
   fprintf (stream, _("\
   --dwarf-start=N        Display DIEs starting at offset N\n"));
+  fprintf (stream, _("\
+  --jobs=N               Display large .debug_info sections using N processes\n"));
 #ifdef ENABLE_LIBCTF
   fprintf (stream, _("\
   --ctf=<number|name>    Display CTF info from section <number|name>\n"));
@@ -6565,6 +6573,24 @@ parse_args (struct dump_data *dumpdata, int argc, char ** argv)
 	case OPTION_DWARF_CHECK:
 	  dwarf_check = true;
 	  break;
+	case OPTION_JOBS:
+	  {
+	    char *cp;
+	    unsigned long jobs = strtoul (optarg, & cp, 0);
+
+	    if (*cp != '\0' || jobs > UINT_MAX)
+	      {
+		error (_("Invalid number of jobs: %s\n"), optarg);
+		usage (stderr);
+	      }
+	    dwarf_jobs = jobs;
+	    if (dwarf_jobs == 0)
+	      {
+		error (_("The number of jobs must be at least 1\n"));
+		usage (stderr);
+	      }
+	  }
+	  break;
 	case OPTION_CTF_DUMP:
 	  do_ctf = true;
 	  request_dump (dumpdata, CTF_DUMP);
@@ -17139,6 +17165,86 @@ dump_section_as_sframe (Elf_Internal_Shdr * section, Filedata * filedata)
   return ret;
 }
 
+#ifdef HAVE_MMAP
+/* Debug sections at least this large are mapped into memory rather
+   than read.  */
+#define MAP_DEBUG_SECTION_MIN_SIZE (64 * 1024)
+
+/* The mappings holding the contents of debug sections, or NULL for the
+   sections whose contents were read into a malloc'ed buffer.  */
+static struct
+{
+  void *addr;
+  size_t size;
+} debug_section_maps[max];
+#endif
+
+/* Get the SIZE bytes of contents at OFFSET of the debug section DEBUG
+   in FILEDATA, like get_data.  Large sections are mapped into memory
+   rather than read, so that their pages are only loaded when they are
+   used, and can be dropped again by the kernel.  The mapping is private,
+   so the contents can still be relocated in place.  */
+
+static unsigned char *
+get_debug_section_data (enum dwarf_section_display_enum debug,
+			Filedata *filedata,
+			uint64_t offset,
+			uint64_t size,
+			const char *reason)
+{
+#ifdef HAVE_MMAP
+  uint64_t file_offset = filedata->archive_file_offset + offset;
+
+  /* The byte following the section is set to zero, like the extra byte
+     allocated by get_data, so it must be part of the file.  */
+  if (size >= MAP_DEBUG_SECTION_MIN_SIZE
+      && (size_t) size == size
+      && filedata->archive_file_offset <= filedata->file_size
+      && offset < filedata->file_size - filedata->archive_file_offset
+      && size < (filedata->file_size - filedata->archive_file_offset
+		 - offset))
+    {
+      uint64_t page_size = getpagesize ();
+      uint64_t map_offset = file_offset & ~(page_size - 1);
+      size_t map_size = file_offset - map_offset + size + 1;
+      void *map;
+
+      map = mmap (NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+		  fileno (filedata->handle), map_offset);
+      if (map != MAP_FAILED)
+	{
+	  unsigned char *data = ((unsigned char *) map
+				 + (file_offset - map_offset));
+
+	  data[size] = 0;
+	  debug_section_maps[debug].addr = map;
+	  debug_section_maps[debug].size = map_size;
+	  return data;
+	}
+    }
+#endif
+
+  return (unsigned char *) get_data (NULL, filedata, offset, 1, size, reason);
+}
+
+/* Free DATA, the contents of the debug section DEBUG, returned by
+   get_debug_section_data.  */
+
+static void
+free_debug_section_data (enum dwarf_section_display_enum debug,
+			 unsigned char *data)
+{
+#ifdef HAVE_MMAP
+  if (debug_section_maps[debug].addr != NULL)
+    {
+      munmap (debug_section_maps[debug].addr, debug_section_maps[debug].size);
+      debug_section_maps[debug].addr = NULL;
+      return;
+    }
+#endif
+  free (data);
+}
+
 static bool
 load_specific_debug_section (enum dwarf_section_display_enum  debug,
 			     const Elf_Internal_Shdr *        sec,
@@ -17153,15 +17259,14 @@ load_specific_debug_section (enum dwarf_section_display_enum  debug,
       /* If it is already loaded, do nothing.  */
       if (streq (section->filename, filedata->file_name))
 	return true;
-      free (section->start);
+      free_debug_section_data (debug, section->start);
     }
 
   snprintf (buf, sizeof (buf), _("%s section data"), section->name);
   section->address = sec->sh_addr;
   section->filename = filedata->file_name;
-  section->start = (unsigned char *) get_data (NULL, filedata,
-                                               sec->sh_offset, 1,
-                                               sec->sh_size, buf);
+  section->start = get_debug_section_data (debug, filedata, sec->sh_offset,
+					   sec->sh_size, buf);
   if (section->start == NULL)
     section->size = 0;
   else
@@ -17231,7 +17336,7 @@ load_specific_debug_section (enum dwarf_section_display_enum  debug,
 	    {
 	      /* Free the compressed buffer, update the section buffer
 		 and the section size if uncompress is successful.  */
-	      free (section->start);
+	      free_debug_section_data (debug, section->start);
 	      section->start = start;
 	    }
 	  else
@@ -17469,7 +17574,7 @@ free_debug_section (enum dwarf_section_display_enum debug)
   if (section->start == NULL)
     return;
 
-  free ((char *) section->start);
+  free_debug_section_data (debug, section->start);
   section->start = NULL;
   section->address = 0;
   section->size = 0;
@@ -0,0 +1,26 @@
+/* Assembler source used to create an object file with a large debug
+   section for testing reads of part of a compressed section.
+
+   Copyright (C) 2025 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+	/* 1.5 MiB of distinct words, so that the section spans more than
+	   one 1 MiB frame when compressed as seekable zstd.  */
+	.section .debug_range,"",%progbits
+	.set	value, 0
+	.rept	0x60000
+	.4byte	value
+	.set	value, value + 1
+	.endr
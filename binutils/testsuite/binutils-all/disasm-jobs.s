@@ -0,0 +1,13 @@
+	/* 64 KiB of text, with a symbol, a line and a reloc every 256
+	   bytes, so that objdump --jobs splits it between workers.  */
+	.file	1 "disasm-jobs.c"
+	.text
+	.macro	block
+jobs\@:
+	.loc	1 \@
+	.4byte	jobs_ext
+	.fill	63, 4, 0x12345678
+	.endm
+	.rept	256
+	block
+	.endr
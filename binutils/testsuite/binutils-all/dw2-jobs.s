@@ -0,0 +1,62 @@
+	/* About 200 KiB of .debug_info in 300 small units, so that
+	   readelf and objdump --jobs split it between workers.  With
+	   WARN defined, each unit has a DW_AT_producer whose string
+	   offset is out of range, so that it is displayed with a
+	   warning.  */
+
+	.section .debug_abbrev,"",%progbits
+	.uleb128 1		/* Abbrev code */
+	.uleb128 0x11		/* DW_TAG_compile_unit */
+	.byte	1		/* has_children */
+	.uleb128 0x3		/* DW_AT_name */
+	.uleb128 0x8		/* DW_FORM_string */
+	.uleb128 0x13		/* DW_AT_language */
+	.uleb128 0xb		/* DW_FORM_data1 */
+	.ifdef	WARN
+	.uleb128 0x25		/* DW_AT_producer */
+	.uleb128 0xe		/* DW_FORM_strp */
+	.endif
+	.byte	0, 0
+	.uleb128 2		/* Abbrev code */
+	.uleb128 0x24		/* DW_TAG_base_type */
+	.byte	0		/* has_children */
+	.uleb128 0x3		/* DW_AT_name */
+	.uleb128 0x8		/* DW_FORM_string */
+	.uleb128 0xb		/* DW_AT_byte_size */
+	.uleb128 0xb		/* DW_FORM_data1 */
+	.uleb128 0x3e		/* DW_AT_encoding */
+	.uleb128 0xb		/* DW_FORM_data1 */
+	.byte	0, 0
+	.byte	0
+
+	.section .debug_info,"",%progbits
+	.macro	unit
+	.4byte	.Lunit_end\@ - .Lunit_start\@	/* Length of unit */
+.Lunit_start\@:
+	.2byte	4			/* DWARF version */
+	.4byte	0			/* Offset into abbrev section */
+	.byte	4			/* Pointer size */
+	.uleb128 1			/* DW_TAG_compile_unit */
+	.asciz	"unit\@.c"		/* DW_AT_name */
+	.byte	0xc			/* DW_AT_language (C99) */
+	.ifdef	WARN
+	.4byte	0x1000 + \@		/* DW_AT_producer */
+	.endif
+	.rept	32
+	.uleb128 2			/* DW_TAG_base_type */
+	.asciz	"unsigned int"		/* DW_AT_name */
+	.byte	4			/* DW_AT_byte_size */
+	.byte	7			/* DW_AT_encoding (unsigned) */
+	.endr
+	.byte	0			/* End of children of CU */
+.Lunit_end\@:
+	.endm
+
+	.rept	300
+	unit
+	.endr
+
+	.ifdef	WARN
+	.section .debug_str,"MS",%progbits,1
+	.asciz	"producer"
+	.endif
@@ -0,0 +1,157 @@
+/* worker.c -- worker processes for the binutils.
+   Copyright (C) 2025 Free Software Foundation, Inc.
+
+   This file is part of GNU Binutils.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston, MA
+   02110-1301, USA.  */
+
+/* The --jobs options of objcopy, strip, objdump and readelf split
+   their work between forked worker processes.  A worker's standard
+   output and standard error are sent to temporary files, which the
+   parent prints in the order the work would have been done without
+   workers.  These functions do not report errors themselves, as
+   readelf and the other tools report them differently.  */
+
+#include "sysdep.h"
+#include "bfd.h"
+#include "bucomm.h"
+
+#ifdef HAVE_WORKER_PROCESSES
+#include <sys/wait.h>
+
+/* Start worker W.  Returns 0 in the worker, and the process ID of the
+   worker in the parent.  Returns -1, with errno set, if the worker
+   could not be started.  */
+
+pid_t
+start_worker (struct worker *w)
+{
+  int saved_errno;
+
+  /* Anything still buffered would be printed by both processes.  */
+  fflush (stdout);
+  fflush (stderr);
+
+  w->out = tmpfile ();
+  w->err = tmpfile ();
+  if (w->out != NULL && w->err != NULL)
+    {
+      w->pid = fork ();
+      if (w->pid > 0)
+	return w->pid;
+      if (w->pid == 0)
+	{
+	  if (dup2 (fileno (w->out), STDOUT_FILENO) < 0
+	      || dup2 (fileno (w->err), STDERR_FILENO) < 0)
+	    _exit (1);
+	  return 0;
+	}
+    }
+
+  saved_errno = errno;
+  if (w->out != NULL)
+    fclose (w->out);
+  if (w->err != NULL)
+    fclose (w->err);
+  errno = saved_errno;
+  return -1;
+}
+
+/* Called by a worker when it has done its work.  Exits with STATUS.  */
+
+void
+finish_worker (int status)
+{
+  fflush (stdout);
+  fflush (stderr);
+  _exit (status);
+}
+
+/* Wait for worker W.  Returns its exit status, or -1 if it did not
+   exit normally.  W's output can then be read from the start.  */
+
+int
+wait_for_worker (struct worker *w)
+{
+  int status;
+  pid_t pid = waitpid (w->pid, &status, 0);
+
+  /* The worker shares the position of the files, so they can only be
+     rewound once it has stopped writing them.  */
+  rewind (w->out);
+  rewind (w->err);
+  if (pid != w->pid || !WIFEXITED (status))
+    return -1;
+  return WEXITSTATUS (status);
+}
+
+/* Copy LEN bytes, or everything if LEN is negative, from FROM to TO.
+   If TO is NULL the bytes are skipped.  */
+
+void
+copy_worker_output (FILE *from, FILE *to, off_t len)
+{
+  char buf[8192];
+
+  while (len != 0)
+    {
+      size_t want = sizeof (buf);
+      size_t got;
+
+      if (len > 0 && (off_t) want > len)
+	want = len;
+      got = fread (buf, 1, want, from);
+      if (got == 0)
+	break;
+      if (to != NULL)
+	fwrite (buf, 1, got, to);
+      if (len > 0)
+	len -= got;
+    }
+}
+
+/* Print the rest of the standard output of worker W, and then its
+   standard error, unless DISCARD.  Closes W's files.  */
+
+void
+print_worker_output (struct worker *w, bool discard)
+{
+  copy_worker_output (w->out, discard ? NULL : stdout, -1);
+  fflush (stdout);
+  copy_worker_output (w->err, discard ? NULL : stderr, -1);
+  fclose (w->out);
+  fclose (w->err);
+}
+
+/* Return the number of ranges of at least MIN_SIZE bytes that SIZE
+   bytes of work should be split into for JOBS workers.  There are more
+   ranges than workers, so that a range with a lot of output does not
+   hold up the others for long.  The result is at least 1, and at most
+   SIZE / MIN_SIZE if that is larger.  */
+
+uint64_t
+worker_ranges (unsigned int jobs, uint64_t size, uint64_t min_size)
+{
+  uint64_t n = (uint64_t) jobs * 4;
+
+  if (n > size / min_size)
+    n = size / min_size;
+  if (n == 0)
+    n = 1;
+  return n;
+}
+
+#endif /* HAVE_WORKER_PROCESSES */
@@ -245,7 +245,7 @@ Options:\n\
   fprintf (stream, _("\
   --alternate             initially turn on alternate macro syntax\n"));
   fprintf (stream, _("\
-  --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi|zstd}]\n\
+  --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi|zstd|zstd-seekable}]\n\
                           compress DWARF debug sections\n")),
   fprintf (stream, _("\
 		            Default: %s\n"),
@@ -756,9 +756,10 @@ This program has absolutely no warranty.\n"));
 #if defined OBJ_ELF || defined OBJ_MAYBE_ELF
 	      flag_compress_debug = bfd_get_compression_algorithm (optarg);
 #ifndef HAVE_ZSTD
-	      if (flag_compress_debug == COMPRESS_DEBUG_ZSTD)
-		  as_fatal (_ ("--compress-debug-sections=zstd: gas is not "
-			       "built with zstd support"));
+	      if (flag_compress_debug == COMPRESS_DEBUG_ZSTD
+		  || flag_compress_debug == COMPRESS_DEBUG_ZSTD_SEEKABLE)
+		  as_fatal (_ ("--compress-debug-sections=%s: gas is not "
+			       "built with zstd support"), optarg);
 #endif
 	      if (flag_compress_debug == COMPRESS_UNKNOWN)
 		as_fatal (_("Invalid --compress-debug-sections option: `%s'"),
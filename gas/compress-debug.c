@@ -20,22 +20,175 @@
 
 #include "config.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <zlib.h>
 #if HAVE_ZSTD
 #include <zstd.h>
 #endif
 #include "ansidecl.h"
+#include "bfd.h"
+#include "libiberty.h"
 #include "compress-debug.h"
 
+#if HAVE_ZSTD
+/* The state of a zstd compression.  For seekable zstd, the input is
+   compressed in frames of BFD_ZSTD_SEEKABLE_FRAME_SIZE bytes, whose
+   sizes are recorded in a seek table written after the last frame.  */
+
+struct zstd_state
+{
+  ZSTD_CCtx *cctx;
+  bool seekable;
+  /* Set when the current frame is being ended.  */
+  bool ending;
+  /* Set when the seek table is complete.  */
+  bool table_done;
+  /* The uncompressed and compressed sizes of the current frame.  */
+  size_t frame_in;
+  size_t frame_out;
+  /* The number of frames, and the seek table so far.  */
+  unsigned int nframes;
+  unsigned char *table;
+  size_t table_size;
+  size_t table_alloc;
+  /* How much of the seek table has been output.  */
+  size_t table_out;
+};
+
+/* Add the current frame to the seek table of ZS.  */
+
+static void
+add_seekable_frame (struct zstd_state *zs)
+{
+  if (zs->table_size + BFD_ZSTD_SEEKABLE_ENTRY_SIZE > zs->table_alloc)
+    {
+      zs->table_alloc *= 2;
+      zs->table = xrealloc (zs->table, zs->table_alloc);
+    }
+  bfd_putl32 (zs->frame_out, zs->table + zs->table_size);
+  bfd_putl32 (zs->frame_in, zs->table + zs->table_size + 4);
+  zs->table_size += BFD_ZSTD_SEEKABLE_ENTRY_SIZE;
+  zs->nframes++;
+  zs->frame_in = 0;
+  zs->frame_out = 0;
+  zs->ending = false;
+}
+
+/* Compress input from IB into OB for seekable zstd, ending the current
+   frame when it holds BFD_ZSTD_SEEKABLE_FRAME_SIZE bytes of input.
+   Return zero, or a zstd error code.  */
+
+static size_t
+compress_seekable (struct zstd_state *zs, ZSTD_outBuffer *ob,
+		   ZSTD_inBuffer *ib)
+{
+  while (ob->pos < ob->size && (ib->pos < ib->size || zs->ending))
+    {
+      size_t out_start = ob->pos;
+      size_t ret;
+
+      if (zs->ending)
+	{
+	  ZSTD_inBuffer none = { NULL, 0, 0 };
+
+	  ret = ZSTD_compressStream2 (zs->cctx, ob, &none, ZSTD_e_end);
+	  zs->frame_out += ob->pos - out_start;
+	  if (ZSTD_isError (ret))
+	    return ret;
+	  if (ret == 0)
+	    add_seekable_frame (zs);
+	}
+      else
+	{
+	  ZSTD_inBuffer part = { (const char *) ib->src + ib->pos,
+				 ib->size - ib->pos, 0 };
+
+	  if (part.size > BFD_ZSTD_SEEKABLE_FRAME_SIZE - zs->frame_in)
+	    part.size = BFD_ZSTD_SEEKABLE_FRAME_SIZE - zs->frame_in;
+	  ret = ZSTD_compressStream2 (zs->cctx, ob, &part, ZSTD_e_continue);
+	  zs->frame_out += ob->pos - out_start;
+	  if (ZSTD_isError (ret))
+	    return ret;
+	  ib->pos += part.pos;
+	  zs->frame_in += part.pos;
+	  if (zs->frame_in == BFD_ZSTD_SEEKABLE_FRAME_SIZE)
+	    zs->ending = true;
+	}
+    }
+  return 0;
+}
+
+/* End the last frame of a seekable zstd compression, and then output
+   its seek table, into OB.  Return zero when done, one when more
+   output space is needed, or a zstd error code.  */
+
+static size_t
+finish_seekable (struct zstd_state *zs, ZSTD_outBuffer *ob)
+{
+  ZSTD_inBuffer none = { NULL, 0, 0 };
+  size_t ret;
+  size_t n;
+
+  if (!zs->table_done)
+    {
+      if (zs->frame_in != 0)
+	zs->ending = true;
+      ret = compress_seekable (zs, ob, &none);
+      if (ZSTD_isError (ret))
+	return ret;
+      if (zs->ending)
+	return 1;
+
+      if (zs->table_size + BFD_ZSTD_SEEKABLE_FOOTER_SIZE > zs->table_alloc)
+	{
+	  zs->table_alloc += BFD_ZSTD_SEEKABLE_FOOTER_SIZE;
+	  zs->table = xrealloc (zs->table, zs->table_alloc);
+	}
+      bfd_putl32 (zs->nframes, zs->table + zs->table_size);
+      /* No checksums.  */
+      zs->table[zs->table_size + 4] = 0;
+      bfd_putl32 (BFD_ZSTD_SEEKABLE_MAGIC, zs->table + zs->table_size + 5);
+      zs->table_size += BFD_ZSTD_SEEKABLE_FOOTER_SIZE;
+      bfd_putl32 (BFD_ZSTD_SKIPPABLE_MAGIC, zs->table);
+      bfd_putl32 (zs->table_size - 8, zs->table + 4);
+      zs->table_done = true;
+    }
+
+  n = zs->table_size - zs->table_out;
+  if (n > ob->size - ob->pos)
+    n = ob->size - ob->pos;
+  memcpy ((char *) ob->dst + ob->pos, zs->table + zs->table_out, n);
+  ob->pos += n;
+  zs->table_out += n;
+  return zs->table_out < zs->table_size;
+}
+#endif
+
 /* Initialize the compression engine.  */
 
 void *
-compress_init (bool use_zstd)
+compress_init (bool use_zstd, bool seekable)
 {
   if (use_zstd) {
 #if HAVE_ZSTD
-    return ZSTD_createCCtx ();
+    struct zstd_state *zs = XCNEW (struct zstd_state);
+
+    zs->cctx = ZSTD_createCCtx ();
+    if (zs->cctx == NULL)
+      {
+	free (zs);
+	return NULL;
+      }
+    zs->seekable = seekable;
+    if (seekable)
+      {
+	/* Leave room for the skippable frame header.  */
+	zs->table_size = 8;
+	zs->table_alloc = 8 + 16 * BFD_ZSTD_SEEKABLE_ENTRY_SIZE;
+	zs->table = XNEWVEC (unsigned char, zs->table_alloc);
+      }
+    return zs;
 #endif
   }
 
@@ -55,9 +208,15 @@ compress_data (bool use_zstd, void *ctx, const char **next_in, int *avail_in,
   if (use_zstd)
     {
 #if HAVE_ZSTD
+      struct zstd_state *zs = ctx;
       ZSTD_outBuffer ob = { *next_out, *avail_out, 0 };
       ZSTD_inBuffer ib = { *next_in, *avail_in, 0 };
-      size_t ret = ZSTD_compressStream2 (ctx, &ob, &ib, ZSTD_e_continue);
+      size_t ret;
+
+      if (zs->seekable)
+	ret = compress_seekable (zs, &ob, &ib);
+      else
+	ret = ZSTD_compressStream2 (zs->cctx, &ob, &ib, ZSTD_e_continue);
       *next_in += ib.pos;
       *avail_in -= ib.pos;
       *next_out += ob.pos;
@@ -99,16 +258,26 @@ compress_finish (bool use_zstd, void *ctx, char **next_out,
   if (use_zstd)
     {
 #if HAVE_ZSTD
+      struct zstd_state *zs = ctx;
       ZSTD_outBuffer ob = { *next_out, *avail_out, 0 };
       ZSTD_inBuffer ib = { 0, 0, 0 };
-      size_t ret = ZSTD_compressStream2 (ctx, &ob, &ib, ZSTD_e_end);
+      size_t ret;
+
+      if (zs->seekable)
+	ret = finish_seekable (zs, &ob);
+      else
+	ret = ZSTD_compressStream2 (zs->cctx, &ob, &ib, ZSTD_e_end);
       *out_size = ob.pos;
       *next_out += ob.pos;
       *avail_out -= ob.pos;
       if (ZSTD_isError (ret))
 	return -1;
       if (ret == 0)
-	ZSTD_freeCCtx (ctx);
+	{
+	  ZSTD_freeCCtx (zs->cctx);
+	  free (zs->table);
+	  free (zs);
+	}
       return ret ? 1 : 0;
 #endif
     }
@@ -25,8 +25,9 @@
 
 struct z_stream_s;
 
-/* Initialize the compression engine.  */
-extern void *compress_init (bool);
+/* Initialize the compression engine.  If the second argument is true,
+   zstd compression is seekable.  */
+extern void *compress_init (bool, bool);
 
 /* Stream the contents of a frag to the compression engine.  Output
    from the engine goes into the current frag on the obstack.  */
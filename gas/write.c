@@ -1498,7 +1498,8 @@ compress_debug (bfd *abfd, asection *sec, void *xxx ATTRIBUTE_UNUSED)
     return;
 
   bool use_zstd = abfd->flags & BFD_COMPRESS_ZSTD;
-  void *ctx = compress_init (use_zstd);
+  bool seekable = abfd->flags & BFD_COMPRESS_ZSTD_SEEKABLE;
+  void *ctx = compress_init (use_zstd, seekable);
   if (ctx == NULL)
     return;
 
@@ -2527,6 +2528,9 @@ write_object_file (void)
 	flags = BFD_COMPRESS | BFD_COMPRESS_GABI;
       else if (flag_compress_debug == COMPRESS_DEBUG_ZSTD)
 	flags = BFD_COMPRESS | BFD_COMPRESS_GABI | BFD_COMPRESS_ZSTD;
+      else if (flag_compress_debug == COMPRESS_DEBUG_ZSTD_SEEKABLE)
+	flags = (BFD_COMPRESS | BFD_COMPRESS_GABI | BFD_COMPRESS_ZSTD
+		 | BFD_COMPRESS_ZSTD_SEEKABLE);
       stdoutput->flags |= flags & bfd_applicable_file_flags (stdoutput);
       if ((stdoutput->flags & BFD_COMPRESS) != 0)
 	bfd_map_over_sections (stdoutput, compress_debug, (char *) 0);
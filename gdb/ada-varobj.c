@@ -985,13 +985,15 @@ ada_value_has_mutated (const struct varobj *var, struct value *new_val,
      If only part (or none!) of the children have been fetched,
      then only check the ones we fetched.  It does not matter
      to the frontend whether a child that it has not fetched yet
-     has mutated or not. So just assume it hasn't.  */
+     has mutated or not. So just assume it hasn't.  The children
+     that were not fetched are NULL in the children vector.  */
 
   varobj_restrict_range (var->children, &from, &to);
   for (int i = from; i < to; i++)
-    if (ada_varobj_get_name_of_child (new_val, new_type,
-				      var->name.c_str (), i)
-	!= var->children[i]->name)
+    if (var->children[i] != NULL
+	&& (ada_varobj_get_name_of_child (new_val, new_type,
+					  var->name.c_str (), i)
+	    != var->children[i]->name))
       return true;
 
   return false;
@@ -25,6 +25,9 @@
 #include "target.h"
 #include "record.h"
 #include "symtab.h"
+#include "block.h"
+#include "minsyms.h"
+#include "objfiles.h"
 #include "disasm.h"
 #include "source.h"
 #include "filenames.h"
@@ -34,6 +37,7 @@
 #include "cli/cli-utils.h"
 #include "extension.h"
 #include "gdbarch.h"
+#include "gdbsupport/selftest.h"
 
 /* For maintenance commands.  */
 #include "record-btrace.h"
@@ -398,7 +402,7 @@ ftrace_find_call (struct btrace_thread_info *btinfo,
       if (bfun->errcode != 0)
 	continue;
 
-      btrace_insn &last = bfun->insn.back ();
+      btrace_insn last = bfun->insn.back ();
 
       if (last.iclass == BTRACE_INSN_CALL)
 	break;
@@ -542,6 +546,145 @@ ftrace_new_gap (struct btrace_thread_info *btinfo, int errcode,
   return bfun;
 }
 
+/* The symbols found for the last address range looked up by
+   ftrace_update_function.  Consecutive instructions of a trace are
+   mostly in the same function, so this saves looking up the symbols for
+   every instruction.  */
+
+struct ftrace_symbol_cache
+{
+  /* The range of addresses, [START, END), for which MFUN and FUN are
+     valid.  The range is empty if nothing is cached.  */
+  CORE_ADDR start = 0;
+  CORE_ADDR end = 0;
+
+  /* The minimal and full symbol of the function containing the range.
+     FUN may be NULL.  */
+  struct minimal_symbol *mfun = nullptr;
+  struct symbol *fun = nullptr;
+};
+
+/* The symbol cache used while computing a function trace, or NULL.  The
+   cache must not outlive the computation, since the symbols could be
+   freed afterwards.  */
+
+static ftrace_symbol_cache *ftrace_symbols;
+
+/* Narrow [*START, *END), which contains PC, so that it does not overlap
+   the part of BLOCK before or after PC.  */
+
+static void
+ftrace_exclude_block (const struct block *block, CORE_ADDR pc,
+		      CORE_ADDR *start, CORE_ADDR *end)
+{
+  auto exclude = [&] (CORE_ADDR lo, CORE_ADDR hi)
+    {
+      if (hi <= pc)
+	*start = std::max (*start, hi);
+      else if (lo > pc)
+	*end = std::min (*end, lo);
+    };
+
+  if (block->is_contiguous ())
+    exclude (block->start (), block->end ());
+  else
+    for (const blockrange &range : block->ranges ())
+      exclude (range.start (), range.end ());
+}
+
+/* Look up the minimal and full symbols of the function containing PC,
+   storing them in *MFUN and *FUN, and remember them in ftrace_symbols
+   for the surrounding addresses known to have the same symbols.  */
+
+static void
+ftrace_lookup_symbols (CORE_ADDR pc, struct minimal_symbol **mfun,
+		       struct symbol **fun)
+{
+  ftrace_symbol_cache *cache = ftrace_symbols;
+
+  if (cache != nullptr && cache->start <= pc && pc < cache->end)
+    {
+      *mfun = cache->mfun;
+      *fun = cache->fun;
+      return;
+    }
+
+  *fun = find_pc_function (pc);
+  bound_minimal_symbol bmfun = lookup_minimal_symbol_by_pc (pc);
+  *mfun = bmfun.minsym;
+
+  if (cache == nullptr)
+    return;
+
+  cache->start = cache->end = 0;
+  if (bmfun.minsym == nullptr)
+    return;
+
+  /* The minimal symbol is the same up to the next minimal symbol.  */
+  CORE_ADDR start = bmfun.value_address ();
+  CORE_ADDR end = minimal_symbol_upper_bound (bmfun);
+
+  /* The full symbol is the same within the range of its block that
+     contains PC.  */
+  if (*fun != nullptr)
+    {
+      const struct block *block = (*fun)->value_block ();
+      bool found = false;
+
+      if (block->is_contiguous ())
+	{
+	  start = std::max (start, block->start ());
+	  end = std::min (end, block->end ());
+	  found = true;
+	}
+      else
+	for (const blockrange &range : block->ranges ())
+	  if (range.start () <= pc && pc < range.end ())
+	    {
+	      start = std::max (start, range.start ());
+	      end = std::min (end, range.end ());
+	      found = true;
+	      break;
+	    }
+
+      if (!found)
+	return;
+    }
+  else if (bmfun.objfile->has_symbols ())
+    {
+      /* No function contains PC, but a function without a minimal
+	 symbol of its own could contain other addresses of the minimal
+	 symbol.  Only cache the addresses between the functions of the
+	 compunit containing PC.  */
+      struct compunit_symtab *cust = find_pc_compunit_symtab (pc);
+      if (cust == nullptr)
+	return;
+
+      const struct blockvector *bv = cust->blockvector ();
+      if (bv->map () != nullptr)
+	return;
+
+      const struct block *global = bv->global_block ();
+      start = std::max (start, global->start ());
+      end = std::min (end, global->end ());
+      for (int i = FIRST_LOCAL_BLOCK; i < bv->num_blocks (); ++i)
+	{
+	  const struct block *block = bv->block (i);
+
+	  if (block->function () != nullptr)
+	    ftrace_exclude_block (block, pc, &start, &end);
+	}
+    }
+
+  if (start <= pc && pc < end)
+    {
+      cache->start = start;
+      cache->end = end;
+      cache->mfun = *mfun;
+      cache->fun = *fun;
+    }
+}
+
 /* Update the current function segment at the end of the trace in BTINFO with
    respect to the instruction at PC.  This may create new function segments.
    Return the chronologically latest function segment, never NULL.  */
@@ -558,9 +701,7 @@ ftrace_update_function (struct btrace_thread_info *btinfo,
      only a minimal symbol.  */
   if (pc.has_value ())
     {
-      fun = find_pc_function (*pc);
-      bound_minimal_symbol bmfun = lookup_minimal_symbol_by_pc (*pc);
-      mfun = bmfun.minsym;
+      ftrace_lookup_symbols (*pc, &mfun, &fun);
 
       if (fun == nullptr && mfun == nullptr)
 	DEBUG_FTRACE ("no symbol at %s", core_addr_to_string_nz (*pc));
@@ -583,11 +724,11 @@ ftrace_update_function (struct btrace_thread_info *btinfo,
   /* Check the last instruction, if we have one.
      We do this check first, since it allows us to fill in the call stack
      links in addition to the normal flow links.  */
-  btrace_insn *last = NULL;
+  std::optional<btrace_insn> last;
   if (!bfun->insn.empty ())
-    last = &bfun->insn.back ();
+    last = bfun->insn.back ();
 
-  if (last != NULL)
+  if (last.has_value ())
     {
       switch (last->iclass)
 	{
@@ -669,7 +810,8 @@ ftrace_update_function (struct btrace_thread_info *btinfo,
   if (ftrace_function_switched (bfun, mfun, fun))
     {
       DEBUG_FTRACE ("switching from %s in %s at %s",
-		    ftrace_print_insn_addr (last),
+		    ftrace_print_insn_addr (last.has_value ()
+					    ? &*last : nullptr),
 		    ftrace_print_function_name (bfun),
 		    ftrace_print_filename (bfun));
 
@@ -679,6 +821,146 @@ ftrace_update_function (struct btrace_thread_info *btinfo,
   return bfun;
 }
 
+/* See btrace.h.  */
+
+const btrace_insn_list::anchor &
+btrace_insn_list::anchor_before (size_t index) const
+{
+  auto it = std::upper_bound (m_anchors.begin (), m_anchors.end (), index,
+			      [] (size_t idx, const anchor &a)
+			      {
+				return idx < a.index;
+			      });
+  gdb_assert (it != m_anchors.begin ());
+  return *(it - 1);
+}
+
+/* See btrace.h.  */
+
+btrace_insn
+btrace_insn_list::operator[] (size_t index) const
+{
+  gdb_assert (index < m_info.size ());
+
+  gdb_byte info = m_info[index];
+  btrace_insn insn;
+  insn.size = info & LARGE_SIZE;
+  insn.iclass = (enum btrace_insn_class) ((info >> 4) & 0x7);
+  insn.flags = 0;
+  if ((info & 0x80) != 0)
+    insn.flags |= BTRACE_INSN_FLAG_SPECULATIVE;
+
+  if (insn.iclass == BTRACE_INSN_AUX)
+    {
+      auto it = std::lower_bound (m_aux.begin (), m_aux.end (), index,
+				  [] (const aux_entry &a, size_t idx)
+				  {
+				    return a.index < idx;
+				  });
+      gdb_assert (it != m_aux.end () && it->index == index);
+      insn.aux_data_index = it->aux_data_index;
+      return insn;
+    }
+
+  /* Walk forward from the last anchor.  The instructions in between
+     are not anchors, so their sizes fit in their info byte.  */
+  const anchor &a = anchor_before (index);
+  CORE_ADDR pc = a.pc;
+  if (a.index < index)
+    {
+      pc += a.size;
+      for (size_t i = a.index + 1; i < index; ++i)
+	if (((m_info[i] >> 4) & 0x7) != BTRACE_INSN_AUX)
+	  pc += m_info[i] & LARGE_SIZE;
+    }
+  else
+    insn.size = a.size;
+
+  insn.pc = pc;
+  return insn;
+}
+
+/* See btrace.h.  */
+
+void
+btrace_insn_list::push_back (const btrace_insn &insn)
+{
+  size_t index = m_info.size ();
+  gdb_byte info = ((insn.iclass & 0x7) << 4);
+
+  if ((insn.flags & BTRACE_INSN_FLAG_SPECULATIVE) != 0)
+    info |= 0x80;
+
+  if (insn.iclass == BTRACE_INSN_AUX)
+    {
+      m_aux.push_back ({ (unsigned int) index, insn.aux_data_index });
+      m_info.push_back (info);
+      m_last = insn;
+      return;
+    }
+
+  if (insn.size >= LARGE_SIZE
+      || m_anchors.empty ()
+      || insn.pc != m_next_pc
+      || index - m_anchors.back ().index >= ANCHOR_INTERVAL)
+    m_anchors.push_back ({ insn.pc, (unsigned int) index, insn.size });
+
+  info |= std::min<unsigned int> (insn.size, LARGE_SIZE);
+  m_info.push_back (info);
+  m_next_pc = insn.pc + insn.size;
+  m_last = insn;
+}
+
+/* See btrace.h.  */
+
+void
+btrace_insn_list::pop_back ()
+{
+  gdb_assert (!m_info.empty ());
+
+  size_t index = m_info.size () - 1;
+  if (!m_anchors.empty () && m_anchors.back ().index == index)
+    m_anchors.pop_back ();
+  if (!m_aux.empty () && m_aux.back ().index == index)
+    m_aux.pop_back ();
+  m_info.pop_back ();
+
+  if (!m_info.empty ())
+    m_last = (*this)[m_info.size () - 1];
+
+  /* Recompute the address following the last instruction.  */
+  while (index > 0)
+    {
+      --index;
+      btrace_insn last = (*this)[index];
+      if (last.iclass != BTRACE_INSN_AUX)
+	{
+	  m_next_pc = last.pc + last.size;
+	  break;
+	}
+    }
+}
+
+/* See btrace.h.  */
+
+void
+btrace_insn_list::shrink_to_fit ()
+{
+  m_info.shrink_to_fit ();
+  m_anchors.shrink_to_fit ();
+  m_aux.shrink_to_fit ();
+}
+
+/* See btrace.h.  */
+
+size_t
+btrace_insn_list::memory_used () const
+{
+  return (m_info.capacity () * sizeof (gdb_byte)
+	  + m_anchors.capacity () * sizeof (anchor)
+	  + m_aux.capacity () * sizeof (aux_entry));
+}
+
 /* Add the instruction at PC to BFUN's instructions.  */
 
 static void
@@ -1359,12 +1641,12 @@ handle_pt_insn_events (struct btrace_thread_info *btinfo,
 	      pc = event.variant.ptwrite.ip;
 	    else if (!btinfo->functions.empty ())
 	      {
-		std::vector<btrace_insn> &insns
+		const btrace_insn_list &insns
 		  = btinfo->functions.back ().insn;
-		for (auto insn = insns.rbegin (); insn != insns.rend ();
-		     ++insn)
+		for (size_t i = insns.size (); i > 0; --i)
 		  {
-		    switch (insn->iclass)
+		    btrace_insn insn = insns[i - 1];
+		    switch (insn.iclass)
 		    {
 		    case BTRACE_INSN_AUX:
 		      continue;
@@ -1373,7 +1655,7 @@ handle_pt_insn_events (struct btrace_thread_info *btinfo,
 		    case BTRACE_INSN_CALL:
 		    case BTRACE_INSN_RETURN:
 		    case BTRACE_INSN_JUMP:
-		      pc = insn->pc;
+		      pc = insn.pc;
 		      break;
 		    /* No default to rely on compiler warnings.  */
 		    }
@@ -1917,6 +2199,14 @@ btrace_compute_ftrace (struct thread_info *tp, struct btrace_data *btrace,
 		       const struct btrace_cpu *cpu)
 {
   std::vector<unsigned int> gaps;
+  std::vector<btrace_function> &functions = tp->btrace.functions;
+
+  /* The last function segment may be extended by the new trace.  */
+  size_t first_changed = functions.empty () ? 0 : functions.size () - 1;
+
+  ftrace_symbol_cache symbols;
+  scoped_restore restore_symbols
+    = make_scoped_restore (&ftrace_symbols, &symbols);
 
   try
     {
@@ -1930,6 +2220,10 @@ btrace_compute_ftrace (struct thread_info *tp, struct btrace_data *btrace,
     }
 
   btrace_finalize_ftrace (tp, gaps);
+
+  /* Release the memory reserved while adding instructions.  */
+  for (size_t i = first_changed; i < functions.size (); ++i)
+    functions[i].insn.shrink_to_fit ();
 }
 
 /* Add an entry for the current PC.  */
@@ -2077,7 +2371,7 @@ btrace_stitch_bts (struct btrace_data_bts *btrace, struct thread_info *tp)
      chronologically first block in the new trace is the last block in
      the new trace's block vector.  */
   first_new_block = &btrace->blocks->back ();
-  const btrace_insn &last_insn = last_bfun->insn.back ();
+  const btrace_insn last_insn = last_bfun->insn.back ();
 
   /* If the current PC at the end of the block is the same as in our current
      trace, there are two explanations:
@@ -2372,7 +2666,19 @@ btrace_free_objfile (struct objfile *objfile)
 
 /* See btrace.h.  */
 
-const struct btrace_insn *
+size_t
+btrace_insn_memory_used (const struct btrace_thread_info *btinfo)
+{
+  size_t bytes = 0;
+
+  for (const btrace_function &bfun : btinfo->functions)
+    bytes += bfun.insn.memory_used ();
+  return bytes;
+}
+
+/* See btrace.h.  */
+
+std::optional<btrace_insn>
 btrace_insn_get (const struct btrace_insn_iterator *it)
 {
   const struct btrace_function *bfun;
@@ -2383,14 +2689,14 @@ btrace_insn_get (const struct btrace_insn_iterator *it)
 
   /* Check if the iterator points to a gap in the trace.  */
   if (bfun->errcode != 0)
-    return NULL;
+    return {};
 
   /* The index is within the bounds of this function's instruction vector.  */
   end = bfun->insn.size ();
   gdb_assert (0 < end);
   gdb_assert (index < end);
 
-  return &bfun->insn[index];
+  return bfun->insn[index];
 }
 
 /* See btrace.h.  */
@@ -3499,10 +3805,119 @@ show_maint_btrace_pt_skip_pad  (struct ui_file *file, int from_tty,
 }
 
 
+#if GDB_SELF_TEST
+namespace selftests {
+
+/* Test btrace_insn_list.  */
+
+static void
+test_btrace_insn_list ()
+{
+  std::vector<btrace_insn> expected;
+  btrace_insn_list list;
+
+  auto add = [&] (CORE_ADDR pc, gdb_byte size, btrace_insn_class iclass,
+		  btrace_insn_flags flags = 0)
+    {
+      btrace_insn insn;
+      if (iclass == BTRACE_INSN_AUX)
+	insn.aux_data_index = pc;
+      else
+	insn.pc = pc;
+      insn.size = size;
+      insn.iclass = iclass;
+      insn.flags = flags;
+      expected.push_back (insn);
+      list.push_back (insn);
+    };
+
+  auto check = [&] ()
+    {
+      SELF_CHECK (list.size () == expected.size ());
+      for (size_t i = 0; i < expected.size (); ++i)
+	{
+	  btrace_insn insn = list[i];
+	  SELF_CHECK (insn.iclass == expected[i].iclass);
+	  SELF_CHECK (insn.size == expected[i].size);
+	  SELF_CHECK (insn.flags == expected[i].flags);
+	  if (insn.iclass == BTRACE_INSN_AUX)
+	    SELF_CHECK (insn.aux_data_index == expected[i].aux_data_index);
+	  else
+	    SELF_CHECK (insn.pc == expected[i].pc);
+	}
+
+      /* The last instruction is cached; it must match as well.  */
+      if (!expected.empty ())
+	{
+	  btrace_insn last = list.back ();
+	  SELF_CHECK (last.iclass == expected.back ().iclass);
+	  SELF_CHECK (last.size == expected.back ().size);
+	  SELF_CHECK (last.flags == expected.back ().flags);
+	  SELF_CHECK (last.pc == expected.back ().pc);
+	}
+    };
+
+  /* A long run of sequential instructions, so that several anchors are
+     needed.  */
+  CORE_ADDR pc = 0x1000;
+  for (int i = 0; i < 100; ++i)
+    {
+      gdb_byte size = 1 + i % 7;
+      add (pc, size, BTRACE_INSN_OTHER);
+      pc += size;
+    }
+
+  /* An auxiliary instruction does not interrupt the run.  */
+  add (3, 0, BTRACE_INSN_AUX);
+  add (pc, 5, BTRACE_INSN_JUMP, BTRACE_INSN_FLAG_SPECULATIVE);
+
+  /* A jump, and instructions too large for the compact encoding.  */
+  add (0x400000, 15, BTRACE_INSN_OTHER);
+  add (0x40000f, 2, BTRACE_INSN_CALL);
+  add (0x400011, 200, BTRACE_INSN_RETURN);
+  add (0x4000d9, 1, BTRACE_INSN_OTHER);
+  check ();
+
+  SELF_CHECK (list.front ().pc == 0x1000);
+  SELF_CHECK (list.back ().pc == 0x4000d9);
+
+  size_t n = 0;
+  for (btrace_insn insn : list)
+    {
+      SELF_CHECK (insn.iclass == expected[n].iclass);
+      ++n;
+    }
+  SELF_CHECK (n == expected.size ());
+
+  /* Removing instructions must leave the rest intact, and allow adding
+     new instructions that follow the remaining ones.  */
+  for (int i = 0; i < 6; ++i)
+    {
+      list.pop_back ();
+      expected.pop_back ();
+    }
+  check ();
+  add (pc, 3, BTRACE_INSN_OTHER);
+  add (pc + 3, 3, BTRACE_INSN_OTHER);
+  check ();
+
+  list.shrink_to_fit ();
+  check ();
+  SELF_CHECK (list.memory_used () < expected.size () * sizeof (btrace_insn));
+}
+
+} /* namespace selftests */
+#endif /* GDB_SELF_TEST */
+
 /* Initialize btrace maintenance commands.  */
 
 INIT_GDB_FILE (btrace)
 {
+#if GDB_SELF_TEST
+  selftests::register_test ("btrace_insn_list",
+			    selftests::test_btrace_insn_list);
+#endif
+
   add_cmd ("btrace", class_maintenance, maint_info_btrace_cmd,
 	   _("Info about branch tracing data."), &maintenanceinfolist);
 
@@ -96,6 +96,153 @@ struct btrace_insn
   btrace_insn_flags flags;
 };
 
+/* The instructions of a function segment.
+
+   Traces can contain hundreds of millions of instructions, so they are
+   not stored as btrace_insn objects.  Instead, each instruction takes
+   a single byte holding its size, class and flags.  Most instructions
+   directly follow the preceding one, so only the addresses of the
+   instructions that don't are stored, as "anchors"; the address of any
+   other instruction is computed by adding up the sizes of the
+   instructions since the last anchor.  An anchor is also stored every
+   ANCHOR_INTERVAL instructions to bound the cost of that computation.
+   The auxiliary data indices of BTRACE_INSN_AUX instructions are
+   stored separately.
+
+   Instructions are returned by value, decoded on access.  The last
+   instruction is also kept decoded, as it is looked at for every
+   instruction added while the trace is computed.  */
+
+class btrace_insn_list
+{
+public:
+  btrace_insn_list () = default;
+
+  /* Return the number of instructions.  */
+  size_t size () const
+  { return m_info.size (); }
+
+  /* Return true if there are no instructions.  */
+  bool empty () const
+  { return m_info.empty (); }
+
+  /* Return the instruction at INDEX.  */
+  btrace_insn operator[] (size_t index) const;
+
+  /* Return the first and the last instruction.  */
+  btrace_insn front () const
+  { return (*this)[0]; }
+  btrace_insn back () const
+  {
+    gdb_assert (!empty ());
+    return m_last;
+  }
+
+  /* Append INSN.  */
+  void push_back (const btrace_insn &insn);
+
+  /* Remove the last instruction.  */
+  void pop_back ();
+
+  /* Release the memory reserved for future instructions.  */
+  void shrink_to_fit ();
+
+  /* Return the number of bytes used to store the instructions.  */
+  size_t memory_used () const;
+
+  /* An iterator over the instructions.  */
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = btrace_insn;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const btrace_insn *;
+    using reference = btrace_insn;
+
+    const_iterator (const btrace_insn_list *list, size_t index)
+      : m_list (list), m_index (index)
+    {}
+
+    btrace_insn operator* () const
+    { return (*m_list)[m_index]; }
+
+    const_iterator &operator++ ()
+    {
+      ++m_index;
+      return *this;
+    }
+
+    bool operator== (const const_iterator &other) const
+    { return m_index == other.m_index; }
+
+    bool operator!= (const const_iterator &other) const
+    { return m_index != other.m_index; }
+
+  private:
+    const btrace_insn_list *m_list;
+    size_t m_index;
+  };
+
+  const_iterator begin () const
+  { return const_iterator (this, 0); }
+
+  const_iterator end () const
+  { return const_iterator (this, size ()); }
+
+private:
+  /* The maximum distance between two anchors.  */
+  static constexpr size_t ANCHOR_INTERVAL = 32;
+
+  /* The value of the size bits of an instruction too large to fit;
+     its size is stored in its anchor.  */
+  static constexpr unsigned int LARGE_SIZE = 0xf;
+
+  /* An instruction whose address is stored.  */
+  struct anchor
+  {
+    /* The address of the instruction.  */
+    CORE_ADDR pc;
+
+    /* The index of the instruction.  */
+    unsigned int index;
+
+    /* The size of the instruction.  */
+    gdb_byte size;
+  };
+
+  /* The auxiliary data index of a BTRACE_INSN_AUX instruction.  */
+  struct aux_entry
+  {
+    /* The index of the instruction.  */
+    unsigned int index;
+
+    /* Index into btrace_info::aux_data.  */
+    uint64_t aux_data_index;
+  };
+
+  /* Return the last anchor at or before INDEX.  */
+  const anchor &anchor_before (size_t index) const;
+
+  /* The size, class and flags of each instruction.  The size is in the
+     low four bits, the class in the next three bits, and the
+     speculative flag in the top bit.  */
+  std::vector<gdb_byte> m_info;
+
+  /* The anchors, in increasing order of their index.  */
+  std::vector<anchor> m_anchors;
+
+  /* The auxiliary instructions, in increasing order of their index.  */
+  std::vector<aux_entry> m_aux;
+
+  /* The address following the last instruction that is not auxiliary;
+     an instruction added at this address does not need an anchor.  */
+  CORE_ADDR m_next_pc = 0;
+
+  /* The last instruction, if the list is not empty.  */
+  btrace_insn m_last {};
+};
+
 /* Flags for btrace function segments.  */
 enum btrace_function_flag
 {
@@ -178,9 +325,9 @@ struct btrace_function
   unsigned int up = 0;
 
   /* The instructions in this function segment.
-     The instruction vector will be empty if the function segment
+     The instruction list will be empty if the function segment
      represents a decode error.  */
-  std::vector<btrace_insn> insn;
+  btrace_insn_list insn;
 
   /* The error code of a decode error that led to a gap.
      Must be zero unless INSN is empty; non-zero otherwise.  */
@@ -430,10 +577,14 @@ extern void btrace_clear (struct thread_info *);
 /* Clear the branch trace for all threads when an object file goes away.  */
 extern void btrace_free_objfile (struct objfile *);
 
-/* Dereference a branch trace instruction iterator.  Return a pointer to the
+/* Return the number of bytes used to store the instructions of the
+   branch trace of BTINFO.  */
+extern size_t btrace_insn_memory_used (const struct btrace_thread_info *btinfo);
+
+/* Dereference a branch trace instruction iterator.  Return the
    instruction the iterator points to.
-   May return NULL if the iterator points to a gap in the trace.  */
-extern const struct btrace_insn *
+   Returns an empty optional if the iterator points to a gap in the trace.  */
+extern std::optional<btrace_insn>
   btrace_insn_get (const struct btrace_insn_iterator *);
 
 /* Return the error code for a branch trace instruction iterator.  Returns zero
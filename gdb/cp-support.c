@@ -38,11 +38,17 @@
 #include "gdbsupport/gdb-safe-ctype.h"
 #include "gdbsupport/selftest.h"
 #include "gdbsupport/gdb-sigmask.h"
+#include "gdbsupport/scope-exit.h"
 #include <atomic>
 #include "event-top.h"
 #include "run-on-main-thread.h"
 #include "typeprint.h"
 #include "inferior.h"
+#include "gdbsupport/unordered_map.h"
+
+#if CXX_STD_THREAD
+#include <mutex>
+#endif
 
 #define d_left(dc) (dc)->u.s_binary.left
 #define d_right(dc) (dc)->u.s_binary.right
@@ -1614,6 +1620,209 @@ report_failed_demangle (const char *name, bool core_dump_allowed,
 
 #endif
 
+/* The same mangled names are demangled over and over: each objfile
+   linking against a library has its own copies of the names it uses,
+   and the same names are demangled again when printing backtraces, or
+   after reloading the symbols.  To avoid this, the results of
+   gdb_demangle are cached.
+
+   The demangler is called from the worker threads, so the cache is
+   split into shards, each protected by its own mutex, to avoid
+   serializing the threads.  The memory used by the cache is bounded:
+   when a shard grows beyond its share of the limit, it is emptied.  */
+
+/* The maximum number of bytes used by the demangler cache.  Zero
+   disables the cache.  This is read by the worker threads while the
+   main thread may be changing it, hence the atomic.  */
+
+static std::atomic<unsigned int> demangler_cache_size { 16 * 1024 * 1024 };
+
+/* The number of shards of the demangler cache.  */
+
+#define DEMANGLER_CACHE_SHARDS 16
+
+/* A shard of the demangler cache.  */
+
+class demangler_cache_shard
+{
+public:
+  demangler_cache_shard ()
+    : m_storage (new auto_obstack)
+  {
+  }
+
+  DISABLE_COPY_AND_ASSIGN (demangler_cache_shard);
+
+  /* Look up NAME demangled with OPTIONS.  If it is found, set *RESULT
+     to a copy of the demangled name, or to NULL if NAME could not be
+     demangled, and return true.  Otherwise return false.  */
+  bool lookup (std::string_view name, int options,
+	       gdb::unique_xmalloc_ptr<char> *result)
+  {
+#if CXX_STD_THREAD
+    std::lock_guard<std::mutex> guard (m_mutex);
+#endif
+
+    auto iter = m_entries.find ({ name, options });
+    if (iter == m_entries.end ())
+      return false;
+
+    ++m_hits;
+    if (iter->second == nullptr)
+      result->reset (nullptr);
+    else
+      result->reset (xstrdup (iter->second));
+    return true;
+  }
+
+  /* Record that NAME demangled with OPTIONS is DEMANGLED, which may be
+     NULL.  LIMIT is the maximum number of bytes this shard may use.  */
+  void insert (std::string_view name, int options, const char *demangled,
+	       size_t limit)
+  {
+    size_t size = (name.size () + sizeof (entry_key) + sizeof (char *)
+		   + (demangled == nullptr ? 0 : strlen (demangled) + 1));
+
+#if CXX_STD_THREAD
+    std::lock_guard<std::mutex> guard (m_mutex);
+#endif
+
+    if (m_bytes + size > limit)
+      clear_locked ();
+    if (size > limit)
+      return;
+
+    const char *name_copy = obstack_strndup (m_storage.get (), name.data (),
+					     name.size ());
+    const char *demangled_copy
+      = (demangled == nullptr
+	 ? nullptr
+	 : obstack_strdup (m_storage.get (), demangled));
+    if (m_entries.emplace (entry_key { { name_copy, name.size () }, options },
+			   demangled_copy).second)
+      m_bytes += size;
+  }
+
+  /* Remove all the entries of this shard.  */
+  void clear ()
+  {
+#if CXX_STD_THREAD
+    std::lock_guard<std::mutex> guard (m_mutex);
+#endif
+
+    clear_locked ();
+  }
+
+  /* Return the number of lookups that found their entry since this
+     shard was last cleared.  */
+  unsigned int hits ()
+  {
+#if CXX_STD_THREAD
+    std::lock_guard<std::mutex> guard (m_mutex);
+#endif
+
+    return m_hits;
+  }
+
+private:
+
+  /* Like clear, but the lock must be held by the caller.  */
+  void clear_locked ()
+  {
+    m_entries.clear ();
+    m_storage.reset (new auto_obstack);
+    m_bytes = 0;
+    m_hits = 0;
+  }
+
+  /* The key of the cache: a mangled name and the demangling
+     options.  */
+  struct entry_key
+  {
+    std::string_view name;
+    int options;
+
+    bool operator== (const entry_key &other) const
+    {
+      return options == other.options && name == other.name;
+    }
+  };
+
+  struct entry_key_hash
+  {
+    std::size_t operator() (const entry_key &key) const noexcept
+    {
+      return fast_hash (key.name.data (), key.name.size (), key.options);
+    }
+  };
+
+#if CXX_STD_THREAD
+  std::mutex m_mutex;
+#endif
+
+  /* The storage of the names in this shard.  */
+  std::unique_ptr<auto_obstack> m_storage;
+
+  /* The number of bytes used by the entries.  */
+  size_t m_bytes = 0;
+
+  /* The number of successful lookups.  */
+  unsigned int m_hits = 0;
+
+  /* Map a mangled name to its demangled form, or to NULL if it could
+     not be demangled.  */
+  gdb::unordered_map<entry_key, const char *, entry_key_hash> m_entries;
+};
+
+/* The demangler cache.  */
+
+static demangler_cache_shard demangler_cache[DEMANGLER_CACHE_SHARDS];
+
+/* Return the shard of the demangler cache where NAME is stored.  */
+
+static demangler_cache_shard &
+demangler_cache_shard_for (std::string_view name)
+{
+  return demangler_cache[fast_hash (name.data (), name.size ())
+			 % DEMANGLER_CACHE_SHARDS];
+}
+
+/* Remove all the entries of the demangler cache.  */
+
+static void
+demangler_cache_flush ()
+{
+  for (demangler_cache_shard &shard : demangler_cache)
+    shard.clear ();
+}
+
+/* The "maint flush demangler-cache" command.  */
+
+static void
+demangler_cache_flush_command (const char *args, int from_tty)
+{
+  demangler_cache_flush ();
+}
+
+/* The "maint set demangler-cache-size" command.  The new size applies
+   to entries added from now on; the current entries are dropped so that
+   the cache does not exceed it.  */
+
+static void
+set_demangler_cache_size (unsigned int size)
+{
+  demangler_cache_size = size;
+  demangler_cache_flush ();
+}
+
+/* The "maint show demangler-cache-size" command.  */
+
+static unsigned int
+get_demangler_cache_size ()
+{
+  return demangler_cache_size;
+}
+
 /* A wrapper for bfd_demangle.  */
 
 gdb::unique_xmalloc_ptr<char>
@@ -1622,6 +1831,16 @@ gdb_demangle (const char *name, int options)
   gdb::unique_xmalloc_ptr<char> result;
   int crash_signal = 0;
 
+  /* Read the setting once, it may be changed by the main thread while
+     a worker thread is demangling.  */
+  size_t cache_limit
+    = ((size_t) demangler_cache_size.load (std::memory_order_relaxed)
+       / DEMANGLER_CACHE_SHARDS);
+  std::string_view name_view (name);
+  demangler_cache_shard &shard = demangler_cache_shard_for (name_view);
+  if (cache_limit != 0 && shard.lookup (name_view, options, &result))
+    return result;
+
 #ifdef HAVE_WORKING_FORK
   scoped_segv_handler_restore restore_segv
     (catch_demangler_crashes
@@ -1648,7 +1867,11 @@ gdb_demangle (const char *name, int options)
 #endif
 
   if (crash_signal == 0)
-    result.reset (bfd_demangle (NULL, name, options | DMGL_VERBOSE));
+    {
+      result.reset (bfd_demangle (NULL, name, options | DMGL_VERBOSE));
+      if (cache_limit != 0)
+	shard.insert (name_view, options, result.get (), cache_limit);
+    }
 
 #ifdef HAVE_WORKING_FORK
   if (catch_demangler_crashes)
@@ -1815,6 +2038,59 @@ test_cp_search_name_hash ()
 	       == cp_search_name_hash ("func[abi:cxx11]"));
 }
 
+/* Return the number of lookups in the demangler cache that found their
+   entry since the cache was last flushed.  */
+
+static unsigned int
+demangler_cache_hits ()
+{
+  unsigned int hits = 0;
+
+  for (demangler_cache_shard &shard : demangler_cache)
+    hits += shard.hits ();
+  return hits;
+}
+
+/* Test the demangler cache.  */
+
+static void
+test_demangler_cache ()
+{
+  unsigned int saved_size = demangler_cache_size;
+  SCOPE_EXIT { demangler_cache_size = saved_size; };
+  demangler_cache_size = 16 * 1024 * 1024;
+  demangler_cache_flush ();
+
+  /* Demangle each name twice, the second result comes from the
+     cache.  */
+  for (int i = 0; i < 2; ++i)
+    {
+      gdb::unique_xmalloc_ptr<char> name = gdb_demangle ("_Z3fooi", 0);
+      SELF_CHECK (name != nullptr && strcmp (name.get (), "foo") == 0);
+
+      name = gdb_demangle ("_Z3fooi", DMGL_PARAMS);
+      SELF_CHECK (name != nullptr && strcmp (name.get (), "foo(int)") == 0);
+
+      name = gdb_demangle ("not_mangled", DMGL_PARAMS);
+      SELF_CHECK (name == nullptr);
+
+      /* Only the three lookups of the second pass hit.  */
+      SELF_CHECK (demangler_cache_hits () == 3 * i);
+    }
+
+  /* A cache too small to hold the names must still give the right
+     results.  */
+  demangler_cache_size = DEMANGLER_CACHE_SHARDS;
+  demangler_cache_flush ();
+  gdb::unique_xmalloc_ptr<char> name = gdb_demangle ("_Z3fooi", DMGL_PARAMS);
+  SELF_CHECK (name != nullptr && strcmp (name.get (), "foo(int)") == 0);
+  name = gdb_demangle ("_Z3fooi", DMGL_PARAMS);
+  SELF_CHECK (name != nullptr && strcmp (name.get (), "foo(int)") == 0);
+  SELF_CHECK (demangler_cache_hits () == 0);
+
+  demangler_cache_flush ();
+}
+
 } /* namespace selftests */
 
 #endif /* GDB_SELF_TEST */
@@ -2424,6 +2700,24 @@ display the offending symbol."),
   gdb_demangle_attempt_core_dump = can_dump_core (LIMIT_CUR);
 #endif
 
+  add_setshow_zuinteger_cmd ("demangler-cache-size", class_maintenance,
+			     _("\
+Set the size of the demangler cache."), _("\
+Show the size of the demangler cache."), _("\
+The demangler cache remembers the demangled form of symbol names,\n\
+so that the same names are not demangled repeatedly.  The size is in\n\
+bytes.  A size of zero disables the cache."),
+			     set_demangler_cache_size,
+			     get_demangler_cache_size,
+			     NULL,
+			     &maintenance_set_cmdlist,
+			     &maintenance_show_cmdlist);
+
+  add_cmd ("demangler-cache", class_maintenance,
+	   demangler_cache_flush_command,
+	   _("Force gdb to flush its demangler cache."),
+	   &maintenanceflushlist);
+
 #if GDB_SELF_TEST
   selftests::register_test ("cp_symbol_name_matches",
 			    selftests::test_cp_symbol_name_matches);
@@ -2431,5 +2725,7 @@ display the offending symbol."),
 			    selftests::test_cp_remove_params);
   selftests::register_test ("cp_search_name_hash",
 			    selftests::test_cp_search_name_hash);
+  selftests::register_test ("demangler_cache",
+			    selftests::test_demangler_cache);
 #endif
 }
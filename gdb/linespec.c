@@ -44,7 +44,10 @@
 #include "gdbsupport/function-view.h"
 #include "gdbsupport/def-vector.h"
 #include <algorithm>
+#include <chrono>
 #include "inferior.h"
+#include "event-top.h"
+#include "ui-out.h"
 #include "gdbsupport/unordered_set.h"
 
 /* An enumeration of the various things a user might attempt to
@@ -1115,6 +1118,66 @@ add_sal_to_sals (struct linespec_state *self,
     }
 }
 
+/* Searching for a name in all the objfiles of a big program may need
+   to expand many symtabs, which can take a long time.  An object of
+   this class lets the user know what is going on, by showing a
+   progress meter once the search has been running for a while, and
+   lets the search be interrupted between objfiles.  */
+
+class linespec_search_progress
+{
+public:
+  /* NAME is the name being searched for, in TOTAL objfiles.  */
+  linespec_search_progress (const char *name, int total)
+    : m_name (name),
+      m_total (total),
+      m_start (std::chrono::steady_clock::now ())
+  {
+  }
+
+  DISABLE_COPY_AND_ASSIGN (linespec_search_progress);
+
+  /* Called before searching each objfile.  */
+  void next_objfile ()
+  {
+    QUIT;
+
+    if (!m_progress.has_value ())
+      {
+	if (std::chrono::steady_clock::now () - m_start < delay)
+	  {
+	    ++m_done;
+	    return;
+	  }
+
+	m_progress.emplace ();
+      }
+
+    m_progress->update_progress
+      (string_printf (_("Searching for \"%s\""), m_name), _("objfiles"),
+       (double) m_done / m_total, m_total);
+    ++m_done;
+  }
+
+private:
+  /* How long the search runs before progress is displayed.  */
+  static constexpr std::chrono::seconds delay {1};
+
+  /* The name being searched for.  */
+  const char *m_name;
+
+  /* The total number of objfiles to search, and the number searched so
+     far.  */
+  int m_total;
+  int m_done = 0;
+
+  /* When the search started.  */
+  std::chrono::steady_clock::time_point m_start;
+
+  /* The progress meter, once it is displayed.  */
+  std::optional<ui_out::progress_update> m_progress;
+};
+
 /* A helper that walks over all matching symtabs in all objfiles and
    calls CALLBACK for each symbol matching NAME.  If SEARCH_PSPACE is
    not NULL, then the search is restricted to just that program
@@ -1129,6 +1192,15 @@ iterate_over_all_matching_symtabs
    struct program_space *search_pspace, bool include_inline,
    gdb::function_view<symbol_found_callback_ftype> callback)
 {
+  int n_objfiles = 0;
+  for (struct program_space *pspace : program_spaces)
+    if ((search_pspace == NULL || search_pspace == pspace)
+	&& !pspace->executing_startup)
+      for (objfile *objfile ATTRIBUTE_UNUSED : pspace->objfiles ())
+	++n_objfiles;
+
+  linespec_search_progress progress (lookup_name.c_str (), n_objfiles);
+
   for (struct program_space *pspace : program_spaces)
     {
       if (search_pspace != NULL && search_pspace != pspace)
@@ -1140,6 +1212,8 @@ iterate_over_all_matching_symtabs
 
       for (objfile *objfile : pspace->objfiles ())
 	{
+	  progress.next_objfile ();
+
 	  objfile->expand_symtabs_matching (NULL, &lookup_name, NULL, NULL,
 					    (SEARCH_GLOBAL_BLOCK
 					     | SEARCH_STATIC_BLOCK),
@@ -351,6 +351,91 @@ print_string_repr (PyObject *printer, const char *hint,
   return result;
 }
 
+/* See python-internal.h.  */
+
+bool
+gdbpy_has_child_locations (PyObject *printer)
+{
+  return (PyObject_TypeCheck (printer, &printer_object_type)
+	  && PyObject_HasAttrString (printer, "child_locations"));
+}
+
+/* See python-internal.h.  */
+
+gdbpy_ref<>
+gdbpy_fetch_child_page (PyObject *iter, unsigned int count)
+{
+  gdbpy_ref<> page (PyList_New (0));
+  if (page == NULL)
+    return NULL;
+
+  std::vector<struct value *> values;
+  while (values.size () < count)
+    {
+      gdbpy_ref<> item (PyIter_Next (iter));
+      if (item == NULL)
+	{
+	  if (PyErr_Occurred ())
+	    return NULL;
+	  break;
+	}
+
+      PyObject *name, *py_addr, *py_type;
+      if (! PyTuple_Check (item.get ()) || PyTuple_Size (item.get ()) != 3)
+	{
+	  PyErr_SetString (PyExc_TypeError,
+			   _("Result of child_locations iterator not a tuple"
+			     " of three elements."));
+	  return NULL;
+	}
+      if (! PyArg_ParseTuple (item.get (), "OOO", &name, &py_addr, &py_type))
+	return NULL;
+
+      CORE_ADDR addr;
+      if (get_addr_from_python (py_addr, &addr) < 0)
+	return NULL;
+
+      struct type *type = type_object_to_type (py_type);
+      if (type == NULL)
+	{
+	  PyErr_SetString (PyExc_TypeError,
+			   _("Child type is not a gdb.Type."));
+	  return NULL;
+	}
+
+      gdbpy_ref<> val_obj;
+      try
+	{
+	  struct value *val = value_at_lazy (type, addr);
+
+	  val_obj.reset (value_to_value_object (val));
+	  values.push_back (val);
+	}
+      catch (const gdb_exception &except)
+	{
+	  return gdbpy_handle_gdb_exception (nullptr, except);
+	}
+      if (val_obj == NULL)
+	return NULL;
+
+      gdbpy_ref<> child (PyTuple_Pack (2, name, val_obj.get ()));
+      if (child == NULL || PyList_Append (page.get (), child.get ()) < 0)
+	return NULL;
+    }
+
+  /* The values are kept alive by the Python objects in PAGE.  */
+  try
+    {
+      value::fetch_lazy_memory_batch (values);
+    }
+  catch (const gdb_exception &except)
+    {
+      return gdbpy_handle_gdb_exception (nullptr, except);
+    }
+
+  return page;
+}
+
 /* Helper for gdbpy_apply_val_pretty_printer that formats children of the
    printer, if any exist.  If is_py_none is true, then nothing has
    been printed by to_string, and format output accordingly. */
@@ -364,7 +449,12 @@ print_children (PyObject *printer, const char *hint,
   int is_map, is_array, done_flag, pretty;
   unsigned int i;
 
-  if (! PyObject_HasAttr (printer, gdbpy_children_cst))
+  /* Printers derived from gdb.ValuePrinter may describe their children
+     by location, in which case the children are read a page at a
+     time.  */
+  bool by_location = gdbpy_has_child_locations (printer);
+
+  if (! by_location && ! PyObject_HasAttr (printer, gdbpy_children_cst))
     return;
 
   /* If we are printing a map or an array, we want some special
@@ -372,8 +462,12 @@ print_children (PyObject *printer, const char *hint,
   is_map = hint && ! strcmp (hint, "map");
   is_array = hint && ! strcmp (hint, "array");
 
-  gdbpy_ref<> children (PyObject_CallMethodObjArgs (printer, gdbpy_children_cst,
-						    NULL));
+  gdbpy_ref<> children;
+  if (by_location)
+    children = gdbpy_call_method (printer, "child_locations");
+  else
+    children.reset (PyObject_CallMethodObjArgs (printer, gdbpy_children_cst,
+						NULL));
   if (children == NULL)
     {
       print_stack_unless_memory_error (stream);
@@ -399,13 +493,32 @@ print_children (PyObject *printer, const char *hint,
 	pretty = options->prettyformat_structs;
     }
 
+  gdbpy_ref<> page;
+  Py_ssize_t page_index = 0;
+
   done_flag = 0;
   for (i = 0; i < options->print_max; ++i)
     {
       PyObject *py_v;
       const char *name;
 
-      gdbpy_ref<> item (PyIter_Next (iter.get ()));
+      gdbpy_ref<> item;
+      if (by_location)
+	{
+	  if (page == NULL || page_index == PyList_Size (page.get ()))
+	    {
+	      page = gdbpy_fetch_child_page (iter.get (),
+					     std::min (options->print_max - i,
+						       (unsigned int)
+						       CHILD_LOCATIONS_PAGE_SIZE));
+	      page_index = 0;
+	    }
+	  if (page != NULL && page_index < PyList_Size (page.get ()))
+	    item = gdbpy_ref<>::new_reference (PyList_GetItem (page.get (),
+								page_index++));
+	}
+      else
+	item.reset (PyIter_Next (iter.get ()));
       if (item == NULL)
 	{
 	  if (PyErr_Occurred ())
@@ -56,12 +56,13 @@ static PyTypeObject btpy_list_type = {
 };
 
 /* Returns either a btrace_insn for the given Python gdb.RecordInstruction
-   object or sets an appropriate Python exception and returns NULL.  */
+   object or sets an appropriate Python exception and returns an empty
+   optional.  */
 
-static const btrace_insn *
+static std::optional<btrace_insn>
 btrace_insn_from_recpy_insn (const PyObject * const pyobject)
 {
-  const btrace_insn *insn;
+  std::optional<btrace_insn> insn;
   const recpy_element_object *obj;
   thread_info *tinfo;
   btrace_insn_iterator iter;
@@ -69,7 +70,7 @@ btrace_insn_from_recpy_insn (const PyObject * const pyobject)
   if (Py_TYPE (pyobject) != &recpy_insn_type)
     {
       PyErr_Format (gdbpy_gdb_error, _("Must be gdb.RecordInstruction"));
-      return NULL;
+      return {};
     }
 
   obj = (const recpy_element_object *) pyobject;
@@ -78,20 +79,20 @@ btrace_insn_from_recpy_insn (const PyObject * const pyobject)
   if (tinfo == NULL || btrace_is_empty (tinfo))
     {
       PyErr_Format (gdbpy_gdb_error, _("No such instruction."));
-      return NULL;
+      return {};
     }
 
   if (btrace_find_insn_by_number (&iter, &tinfo->btrace, obj->number) == 0)
     {
       PyErr_Format (gdbpy_gdb_error, _("No such instruction."));
-      return NULL;
+      return {};
     }
 
   insn = btrace_insn_get (&iter);
-  if (insn == NULL)
+  if (!insn.has_value ())
     {
       PyErr_Format (gdbpy_gdb_error, _("Not a valid instruction."));
-      return NULL;
+      return {};
     }
 
   return insn;
@@ -169,8 +170,8 @@ btpy_item_new (thread_info *tinfo, Py_ssize_t number)
       return recpy_gap_new (err_code, err_string, number);
     }
 
-  const struct btrace_insn *insn = btrace_insn_get (&iter);
-  gdb_assert (insn != nullptr);
+  std::optional<btrace_insn> insn = btrace_insn_get (&iter);
+  gdb_assert (insn.has_value ());
 
   if (insn->iclass == BTRACE_INSN_AUX)
     return recpy_aux_new (tinfo, RECORD_METHOD_BTRACE, number);
@@ -205,10 +206,10 @@ btpy_list_new (thread_info *thread, Py_ssize_t first, Py_ssize_t last,
 PyObject *
 recpy_bt_insn_sal (PyObject *self, void *closure)
 {
-  const btrace_insn * const insn = btrace_insn_from_recpy_insn (self);
+  std::optional<btrace_insn> insn = btrace_insn_from_recpy_insn (self);
   PyObject *result = NULL;
 
-  if (insn == NULL)
+  if (!insn.has_value ())
     return NULL;
 
   try
@@ -229,9 +230,9 @@ recpy_bt_insn_sal (PyObject *self, void *closure)
 PyObject *
 recpy_bt_insn_pc (PyObject *self, void *closure)
 {
-  const btrace_insn * const insn = btrace_insn_from_recpy_insn (self);
+  std::optional<btrace_insn> insn = btrace_insn_from_recpy_insn (self);
 
-  if (insn == NULL)
+  if (!insn.has_value ())
     return NULL;
 
   return gdb_py_object_from_ulongest (insn->pc).release ();
@@ -243,9 +244,9 @@ recpy_bt_insn_pc (PyObject *self, void *closure)
 PyObject *
 recpy_bt_insn_size (PyObject *self, void *closure)
 {
-  const btrace_insn * const insn = btrace_insn_from_recpy_insn (self);
+  std::optional<btrace_insn> insn = btrace_insn_from_recpy_insn (self);
 
-  if (insn == NULL)
+  if (!insn.has_value ())
     return NULL;
 
   return gdb_py_object_from_longest (insn->size).release ();
@@ -257,9 +258,9 @@ recpy_bt_insn_size (PyObject *self, void *closure)
 PyObject *
 recpy_bt_insn_is_speculative (PyObject *self, void *closure)
 {
-  const btrace_insn * const insn = btrace_insn_from_recpy_insn (self);
+  std::optional<btrace_insn> insn = btrace_insn_from_recpy_insn (self);
 
-  if (insn == NULL)
+  if (!insn.has_value ())
     return NULL;
 
   if (insn->flags & BTRACE_INSN_FLAG_SPECULATIVE)
@@ -274,11 +275,11 @@ recpy_bt_insn_is_speculative (PyObject *self, void *closure)
 PyObject *
 recpy_bt_insn_data (PyObject *self, void *closure)
 {
-  const btrace_insn * const insn = btrace_insn_from_recpy_insn (self);
+  std::optional<btrace_insn> insn = btrace_insn_from_recpy_insn (self);
   gdb::byte_vector buffer;
   PyObject *object;
 
-  if (insn == NULL)
+  if (!insn.has_value ())
     return NULL;
 
   try
@@ -306,10 +307,10 @@ recpy_bt_insn_data (PyObject *self, void *closure)
 PyObject *
 recpy_bt_insn_decoded (PyObject *self, void *closure)
 {
-  const btrace_insn * const insn = btrace_insn_from_recpy_insn (self);
+  std::optional<btrace_insn> insn = btrace_insn_from_recpy_insn (self);
   string_file strfile;
 
-  if (insn == NULL)
+  if (!insn.has_value ())
     return NULL;
 
   try
@@ -440,7 +441,7 @@ recpy_bt_func_next (PyObject *self, void *closure)
 PyObject *
 recpy_bt_aux_data (PyObject *self, void *closure)
 {
-  const btrace_insn *insn;
+  std::optional<btrace_insn> insn;
   const recpy_element_object *obj;
   thread_info *tinfo;
   btrace_insn_iterator iter;
@@ -467,7 +468,7 @@ recpy_bt_aux_data (PyObject *self, void *closure)
     }
 
   insn = btrace_insn_get (&iter);
-  if (insn == nullptr || insn->iclass != BTRACE_INSN_AUX)
+  if (!insn.has_value () || insn->iclass != BTRACE_INSN_AUX)
     {
       PyErr_Format (gdbpy_gdb_error, _("Not a valid auxiliary object."));
       return nullptr;
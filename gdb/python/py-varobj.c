@@ -24,7 +24,7 @@
 struct py_varobj_iter : public varobj_iter
 {
   py_varobj_iter (struct varobj *var, gdbpy_ref<> &&pyiter,
-		  const value_print_options *opts);
+		  bool by_location, const value_print_options *opts);
   ~py_varobj_iter () override;
 
   std::unique_ptr<varobj_item> next () override;
@@ -40,9 +40,20 @@ struct py_varobj_iter : public varobj_iter
   int m_next_raw_index = 0;
 
   /* The python iterator returned by the printer's 'children' method,
-     or NULL if not available.  */
+     or by its 'child_locations' method if BY_LOCATION, or NULL if not
+     available.  */
   PyObject *m_iter;
 
+  /* Whether M_ITER describes the children by location.  The children
+     are then read from it a page at a time, see
+     gdbpy_fetch_child_page.  */
+  bool m_by_location;
+
+  /* If M_BY_LOCATION, the current page of children, and the index of
+     the next child to return from it.  */
+  PyObject *m_page = nullptr;
+  Py_ssize_t m_page_index = 0;
+
   /* The print options to use.  */
   value_print_options m_opts;
 };
@@ -54,6 +65,7 @@ py_varobj_iter::~py_varobj_iter ()
 {
   gdbpy_enter_varobj enter_py (m_var);
   Py_XDECREF (m_iter);
+  Py_XDECREF (m_page);
 }
 
 /* Implementation of the 'next' method of pretty-printed varobj
@@ -74,7 +86,22 @@ py_varobj_iter::next ()
   scoped_restore set_options = make_scoped_restore (&gdbpy_current_print_options,
 						    &m_opts);
 
-  gdbpy_ref<> item (PyIter_Next (m_iter));
+  gdbpy_ref<> item;
+  if (m_by_location)
+    {
+      if (m_page == NULL || m_page_index == PyList_Size (m_page))
+	{
+	  Py_XDECREF (m_page);
+	  m_page = gdbpy_fetch_child_page (m_iter,
+					   CHILD_LOCATIONS_PAGE_SIZE).release ();
+	  m_page_index = 0;
+	}
+      if (m_page != NULL && m_page_index < PyList_Size (m_page))
+	item = gdbpy_ref<>::new_reference (PyList_GetItem (m_page,
+							    m_page_index++));
+    }
+  else
+    item.reset (PyIter_Next (m_iter));
 
   if (item == NULL)
     {
@@ -132,9 +159,11 @@ py_varobj_iter::next ()
    python iterator actually responsible for the iteration.  */
 
 py_varobj_iter::py_varobj_iter (struct varobj *var, gdbpy_ref<> &&pyiter,
+				bool by_location,
 				const value_print_options *opts)
   : m_var (var),
     m_iter (pyiter.release ()),
+    m_by_location (by_location),
     m_opts (*opts)
 {
 }
@@ -148,14 +177,21 @@ py_varobj_get_iterator (struct varobj *var, PyObject *printer,
 {
   gdbpy_enter_varobj enter_py (var);
 
-  if (!PyObject_HasAttr (printer, gdbpy_children_cst))
+  /* As when printing, a printer's "child_locations" method is preferred
+     to its "children" method.  */
+  bool by_location = gdbpy_has_child_locations (printer);
+  if (!by_location && !PyObject_HasAttr (printer, gdbpy_children_cst))
     return NULL;
 
   scoped_restore set_options = make_scoped_restore (&gdbpy_current_print_options,
 						    opts);
 
-  gdbpy_ref<> children (PyObject_CallMethodObjArgs (printer, gdbpy_children_cst,
-						    NULL));
+  gdbpy_ref<> children;
+  if (by_location)
+    children = gdbpy_call_method (printer, "child_locations");
+  else
+    children.reset (PyObject_CallMethodObjArgs (printer, gdbpy_children_cst,
+						NULL));
   if (children == NULL)
     {
       gdbpy_print_stack ();
@@ -169,5 +205,6 @@ py_varobj_get_iterator (struct varobj *var, PyObject *printer,
       error (_("Could not get children iterator"));
     }
 
-  return std::make_unique<py_varobj_iter> (var, std::move (iter), opts);
+  return std::make_unique<py_varobj_iter> (var, std::move (iter),
+					   by_location, opts);
 }
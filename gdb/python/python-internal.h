@@ -965,6 +965,25 @@ gdbpy_ref<> apply_varobj_pretty_printer (PyObject *print_obj,
 					 const value_print_options *opts);
 gdbpy_ref<> gdbpy_get_varobj_pretty_printer (struct value *value);
 gdb::unique_xmalloc_ptr<char> gdbpy_get_display_hint (PyObject *printer);
+
+/* Maximum number of children requested from a "child_locations"
+   iterator at once.  The memory of each such page of children is
+   fetched with as few target reads as possible.  */
+#define CHILD_LOCATIONS_PAGE_SIZE 256
+
+/* Return true if the children of PRINTER should be obtained from its
+   "child_locations" method.  This is only used for printers derived
+   from gdb.ValuePrinter.  */
+bool gdbpy_has_child_locations (PyObject *printer);
+
+/* Read up to COUNT items from ITER, the iterator returned by a
+   printer's "child_locations" method.  Each item must be a tuple
+   holding the child's name, address and gdb.Type.  The contents of all
+   the children are fetched from the inferior in bulk, and a list of
+   (name, gdb.Value) tuples, in the form returned by the "children"
+   method, is returned.  The list is empty if ITER is exhausted.  On
+   error, NULL is returned with a Python exception set.  */
+gdbpy_ref<> gdbpy_fetch_child_page (PyObject *iter, unsigned int count);
 PyObject *gdbpy_default_visualizer (PyObject *self, PyObject *args);
 
 PyObject *gdbpy_print_options (PyObject *self, PyObject *args);
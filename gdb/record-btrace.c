@@ -596,7 +596,7 @@ record_btrace_target::info_record ()
 
       /* If the last instruction is not a gap, it is the current instruction
 	 that is not actually part of the record.  */
-      if (btrace_insn_get (&insn) != NULL)
+      if (btrace_insn_get (&insn).has_value ())
 	insns -= 1;
 
       gaps = btinfo->ngaps;
@@ -606,6 +606,8 @@ record_btrace_target::info_record ()
 		"for thread %s (%s).\n"), insns, calls, gaps,
 	      print_thread_id (tp),
 	      target_pid_to_str (tp->ptid).c_str ());
+  gdb_printf (_("Instruction storage: %s bytes.\n"),
+	      pulongest (btrace_insn_memory_used (btinfo)));
 
   if (btrace_is_replaying (tp))
     gdb_printf (_("Replay in progress.  At instruction %u.\n"),
@@ -804,12 +806,12 @@ btrace_insn_history (struct ui_out *uiout,
   for (btrace_insn_iterator it = *begin; btrace_insn_cmp (&it, end) != 0;
 	 btrace_insn_next (&it, 1))
     {
-      const struct btrace_insn *insn;
+      std::optional<btrace_insn> insn;
 
       insn = btrace_insn_get (&it);
 
       /* A NULL instruction indicates a gap in the trace.  */
-      if (insn == NULL)
+      if (!insn.has_value ())
 	{
 	  const struct btrace_config *conf;
 
@@ -1089,7 +1091,7 @@ btrace_compute_src_line_range (const struct btrace_function *bfun,
 
   symtab = sym->symtab ();
 
-  for (const btrace_insn &insn : bfun->insn)
+  for (const btrace_insn insn : bfun->insn)
     {
       struct symtab_and_line sal;
 
@@ -1165,7 +1167,7 @@ btrace_print_aux_insn (struct ui_out *uiout,
 		       const struct btrace_thread_info *btinfo,
 		       int level)
 {
-  for (const btrace_insn &insn : bfun->insn)
+  for (const btrace_insn insn : bfun->insn)
     {
       if (insn.iclass == BTRACE_INSN_AUX)
 	{
@@ -1600,7 +1602,7 @@ record_btrace_target::fetch_registers (struct regcache *regcache, int regno)
 
   if (replay != nullptr && !record_btrace_generating_corefile)
     {
-      const struct btrace_insn *insn;
+      std::optional<btrace_insn> insn;
       struct gdbarch *gdbarch;
       int pcreg;
 
@@ -1614,7 +1616,7 @@ record_btrace_target::fetch_registers (struct regcache *regcache, int regno)
 	return;
 
       insn = btrace_insn_get (replay);
-      gdb_assert (insn != NULL);
+      gdb_assert (insn.has_value ());
 
       regcache->raw_supply (regno, &insn->pc);
     }
@@ -2093,7 +2095,7 @@ record_btrace_start_replaying (struct thread_info *tp)
       btrace_insn_end (replay, btinfo);
 
       /* Skip gaps at the end of the trace.  */
-      while (btrace_insn_get (replay) == NULL)
+      while (!btrace_insn_get (replay).has_value ())
 	{
 	  unsigned int steps;
 
@@ -2353,7 +2355,7 @@ record_btrace_replay_at_breakpoint (struct thread_info *tp)
 {
   struct btrace_insn_iterator *replay;
   struct btrace_thread_info *btinfo;
-  const struct btrace_insn *insn;
+  std::optional<btrace_insn> insn;
 
   btinfo = &tp->btrace;
   replay = btinfo->replay;
@@ -2362,7 +2364,7 @@ record_btrace_replay_at_breakpoint (struct thread_info *tp)
     return 0;
 
   insn = btrace_insn_get (replay);
-  if (insn == NULL)
+  if (!insn.has_value ())
     return 0;
 
   return record_check_stopped_by_breakpoint (tp->inf->aspace.get (), insn->pc,
@@ -2408,8 +2410,8 @@ record_btrace_single_step_forward (struct thread_info *tp)
 	  return btrace_step_no_history ();
 	}
 
-      const struct btrace_insn *insn = btrace_insn_get (replay);
-      if (insn == nullptr)
+      std::optional<btrace_insn> insn = btrace_insn_get (replay);
+      if (!insn.has_value ())
 	continue;
 
       /* If we're stepping a BTRACE_INSN_AUX instruction, print the auxiliary
@@ -2470,8 +2472,8 @@ record_btrace_single_step_backward (struct thread_info *tp)
 	  return btrace_step_no_history ();
 	}
 
-      const struct btrace_insn *insn = btrace_insn_get (replay);
-      if (insn == nullptr)
+      std::optional<btrace_insn> insn = btrace_insn_get (replay);
+      if (!insn.has_value ())
 	continue;
 
       /* Check if we're stepping a BTRACE_INSN_AUX instruction and skip it.  */
@@ -2855,7 +2857,7 @@ record_btrace_target::goto_record_begin ()
   btrace_insn_begin (&begin, &tp->btrace);
 
   /* Skip gaps at the beginning of the trace.  */
-  while (btrace_insn_get (&begin) == NULL)
+  while (!btrace_insn_get (&begin).has_value ())
     {
       unsigned int steps;
 
@@ -2904,8 +2906,8 @@ record_btrace_target::goto_record (ULONGEST insn_number)
   if (found == 0)
     error (_("No such instruction."));
 
-  const struct btrace_insn *insn = btrace_insn_get (&it);
-  if (insn == NULL)
+  std::optional<btrace_insn> insn = btrace_insn_get (&it);
+  if (!insn.has_value ())
     error (_("No such instruction."));
   if (insn->iclass == BTRACE_INSN_AUX)
     error (_("Can't go to an auxiliary instruction."));
@@ -40,6 +40,8 @@
 #include "infrun.h"
 #include "gdbsupport/gdb_unlinker.h"
 #include "gdbsupport/byte-vector.h"
+#include "gdbsupport/unordered_map.h"
+#include "gdbsupport/unordered_set.h"
 #include "gdbsupport/scoped_signal_handler.h"
 #include "async-event.h"
 #include "top.h"
@@ -47,6 +49,7 @@
 #include "interps.h"
 
 #include <signal.h>
+#include <map>
 
 /* This module implements "target record-full", also known as "process
    record and replay".  This target sits on top of a "normal" target
@@ -392,6 +395,202 @@ static struct cmd_list_element *record_full_cmdlist;
 static void record_full_goto_insn (struct record_full_entry *entry,
 				   enum exec_direction_kind dir);
 
+/* The entries of the execution log, and the values they hold, are
+   allocated from chunks of memory of this size.  This avoids the time
+   and space overhead of a heap allocation for each entry.  */
+
+#define RECORD_FULL_CHUNK_SIZE (64 * 1024)
+
+/* Values larger than this are allocated on the heap rather than in
+   the chunks.  */
+
+#define RECORD_FULL_CHUNK_MAX_VALUE 1024
+
+/* An allocator handing out memory from large chunks.  Memory is
+   allocated by bumping a pointer in the current chunk, and a chunk is
+   released once everything allocated in it was freed.  The execution
+   log grows at one end and is deleted from either end, so chunks are
+   released as the log is trimmed.  */
+
+class record_full_arena
+{
+public:
+  record_full_arena () = default;
+
+  DISABLE_COPY_AND_ASSIGN (record_full_arena);
+
+  /* Return SIZE bytes of zeroed memory.  */
+  void *alloc (size_t size);
+
+  /* Free the SIZE bytes at P, allocated by alloc.  */
+  void free (void *p, size_t size);
+
+  /* Return the number of bytes currently allocated.  */
+  size_t bytes_used () const
+  { return m_bytes_used; }
+
+  /* Return the number of bytes of the chunks, including the parts not
+     allocated or already freed.  */
+  size_t bytes_reserved () const
+  { return m_chunks.size () * RECORD_FULL_CHUNK_SIZE; }
+
+private:
+  struct chunk
+  {
+    std::unique_ptr<gdb_byte[]> data;
+
+    /* The offset of the first free byte in DATA.  */
+    size_t top = 0;
+
+    /* The number of allocations in DATA not yet freed.  */
+    size_t live = 0;
+  };
+
+  /* The chunks, indexed by their start address.  */
+  std::map<const gdb_byte *, chunk> m_chunks;
+
+  /* The chunk memory is allocated from, or nullptr.  */
+  chunk *m_current = nullptr;
+
+  size_t m_bytes_used = 0;
+};
+
+void *
+record_full_arena::alloc (size_t size)
+{
+  size = align_up (size, alignof (record_full_entry));
+  gdb_assert (size <= RECORD_FULL_CHUNK_SIZE);
+
+  if (m_current == nullptr || m_current->top + size > RECORD_FULL_CHUNK_SIZE)
+    {
+      chunk c;
+
+      c.data.reset (new gdb_byte[RECORD_FULL_CHUNK_SIZE]);
+      const gdb_byte *start = c.data.get ();
+      m_current = &m_chunks.emplace (start, std::move (c)).first->second;
+    }
+
+  gdb_byte *result = m_current->data.get () + m_current->top;
+  m_current->top += size;
+  m_current->live++;
+  m_bytes_used += size;
+
+  memset (result, 0, size);
+  return result;
+}
+
+void
+record_full_arena::free (void *p, size_t size)
+{
+  size = align_up (size, alignof (record_full_entry));
+
+  const gdb_byte *addr = (const gdb_byte *) p;
+  auto it = m_chunks.upper_bound (addr);
+  gdb_assert (it != m_chunks.begin ());
+  --it;
+  gdb_assert (addr < it->first + RECORD_FULL_CHUNK_SIZE);
+
+  chunk &c = it->second;
+  gdb_assert (c.live > 0);
+  c.live--;
+  m_bytes_used -= size;
+
+  if (c.live == 0)
+    {
+      if (&c == m_current)
+	c.top = 0;
+      else
+	m_chunks.erase (it);
+    }
+}
+
+/* The allocator for the execution log.  */
+
+static record_full_arena record_full_log_arena;
+
+/* The number of bytes of values too large to be allocated from
+   RECORD_FULL_LOG_ARENA.  */
+
+static size_t record_full_log_heap_bytes;
+
+/* Maximum allowed number of bytes used by the execution log, or
+   UINT_MAX for no limit.  */
+
+static unsigned int record_full_memory_max = UINT_MAX;
+
+/* Return the number of bytes used by the execution log.  The chunks of
+   RECORD_FULL_LOG_ARENA are counted whole, as that is the memory the
+   log holds on to.  */
+
+static size_t
+record_full_log_size ()
+{
+  return (record_full_log_arena.bytes_reserved ()
+	  + record_full_log_heap_bytes);
+}
+
+/* Return true if the execution log uses more memory than allowed.  */
+
+static bool
+record_full_log_over_memory_max ()
+{
+  return (record_full_memory_max != UINT_MAX
+	  && record_full_log_size () >= record_full_memory_max);
+}
+
+/* Return the number of bytes of the allocation holding an entry whose
+   value takes LEN bytes.  INLINE_LEN is the space for the value
+   within the entry itself.  */
+
+static inline size_t
+record_full_entry_alloc_size (size_t len, size_t inline_len)
+{
+  if (len > inline_len && len <= RECORD_FULL_CHUNK_MAX_VALUE)
+    return sizeof (struct record_full_entry) + len;
+  return sizeof (struct record_full_entry);
+}
+
+/* Allocate an entry whose value takes LEN bytes, of which INLINE_LEN
+   fit within the entry itself.  Return the entry, and set *VALUE to
+   the separate storage for the value, or nullptr if it fits within the
+   entry.  */
+
+static struct record_full_entry *
+record_full_entry_alloc (size_t len, size_t inline_len, gdb_byte **value)
+{
+  size_t size = record_full_entry_alloc_size (len, inline_len);
+  auto rec = (struct record_full_entry *) record_full_log_arena.alloc (size);
+
+  if (len <= inline_len)
+    *value = nullptr;
+  else if (len <= RECORD_FULL_CHUNK_MAX_VALUE)
+    *value = (gdb_byte *) (rec + 1);
+  else
+    {
+      *value = (gdb_byte *) xmalloc (len);
+      record_full_log_heap_bytes += len;
+    }
+
+  return rec;
+}
+
+/* Free an entry allocated by record_full_entry_alloc, along with
+   VALUE.  */
+
+static void
+record_full_entry_free (struct record_full_entry *rec, size_t len,
+			size_t inline_len, gdb_byte *value)
+{
+  if (len > RECORD_FULL_CHUNK_MAX_VALUE)
+    {
+      xfree (value);
+      record_full_log_heap_bytes -= len;
+    }
+
+  record_full_log_arena.free (rec,
+			      record_full_entry_alloc_size (len, inline_len));
+}
+
 /* Alloc and free functions for record_full_reg, record_full_mem, and
    record_full_end entries.  */
 
@@ -402,13 +601,15 @@ record_full_reg_alloc (struct regcache *regcache, int regnum)
 {
   struct record_full_entry *rec;
   struct gdbarch *gdbarch = regcache->arch ();
+  int len = register_size (gdbarch, regnum);
+  gdb_byte *value;
 
-  rec = XCNEW (struct record_full_entry);
+  rec = record_full_entry_alloc (len, sizeof (rec->u.reg.u.buf), &value);
   rec->type = record_full_reg;
   rec->u.reg.num = regnum;
-  rec->u.reg.len = register_size (gdbarch, regnum);
-  if (rec->u.reg.len > sizeof (rec->u.reg.u.buf))
-    rec->u.reg.u.ptr = (gdb_byte *) xmalloc (rec->u.reg.len);
+  rec->u.reg.len = len;
+  if (value != nullptr)
+    rec->u.reg.u.ptr = value;
 
   return rec;
 }
@@ -419,9 +620,8 @@ static inline void
 record_full_reg_release (struct record_full_entry *rec)
 {
   gdb_assert (rec->type == record_full_reg);
-  if (rec->u.reg.len > sizeof (rec->u.reg.u.buf))
-    xfree (rec->u.reg.u.ptr);
-  xfree (rec);
+  record_full_entry_free (rec, rec->u.reg.len, sizeof (rec->u.reg.u.buf),
+			  rec->u.reg.u.ptr);
 }
 
 /* Alloc a record_full_mem record entry.  */
@@ -430,13 +630,14 @@ static inline struct record_full_entry *
 record_full_mem_alloc (CORE_ADDR addr, int len)
 {
   struct record_full_entry *rec;
+  gdb_byte *value;
 
-  rec = XCNEW (struct record_full_entry);
+  rec = record_full_entry_alloc (len, sizeof (rec->u.mem.u.buf), &value);
   rec->type = record_full_mem;
   rec->u.mem.addr = addr;
   rec->u.mem.len = len;
-  if (rec->u.mem.len > sizeof (rec->u.mem.u.buf))
-    rec->u.mem.u.ptr = (gdb_byte *) xmalloc (len);
+  if (value != nullptr)
+    rec->u.mem.u.ptr = value;
 
   return rec;
 }
@@ -447,9 +648,8 @@ static inline void
 record_full_mem_release (struct record_full_entry *rec)
 {
   gdb_assert (rec->type == record_full_mem);
-  if (rec->u.mem.len > sizeof (rec->u.mem.u.buf))
-    xfree (rec->u.mem.u.ptr);
-  xfree (rec);
+  record_full_entry_free (rec, rec->u.mem.len, sizeof (rec->u.mem.u.buf),
+			  rec->u.mem.u.ptr);
 }
 
 /* Alloc a record_full_end record entry.  */
@@ -458,8 +658,9 @@ static inline struct record_full_entry *
 record_full_end_alloc (void)
 {
   struct record_full_entry *rec;
+  gdb_byte *value;
 
-  rec = XCNEW (struct record_full_entry);
+  rec = record_full_entry_alloc (0, 0, &value);
   rec->type = record_full_end;
 
   return rec;
@@ -470,7 +671,7 @@ record_full_end_alloc (void)
 static inline void
 record_full_end_release (struct record_full_entry *rec)
 {
-  xfree (rec);
+  record_full_entry_free (rec, 0, 0, nullptr);
 }
 
 /* Free one record entry, any type.
@@ -696,7 +897,8 @@ record_full_arch_list_add_end (void)
 static void
 record_full_check_insn_num (void)
 {
-  if (record_full_insn_num == record_full_insn_max_num)
+  if (record_full_insn_num == record_full_insn_max_num
+      || record_full_log_over_memory_max ())
     {
       /* Ask user what to do.  */
       if (record_full_stop_at_limit)
@@ -710,6 +912,26 @@ record_full_check_insn_num (void)
     }
 }
 
+/* Account for the instruction just added to the end of the log, and
+   delete instructions from the beginning of the log to keep it within
+   its limits.  */
+
+static void
+record_full_trim_log (void)
+{
+  if (record_full_insn_num == record_full_insn_max_num)
+    record_full_list_release_first ();
+  else
+    record_full_insn_num++;
+
+  /* Always keep the instruction just added.  */
+  while (record_full_insn_num > 1 && record_full_log_over_memory_max ())
+    {
+      record_full_list_release_first ();
+      record_full_insn_num--;
+    }
+}
+
 /* Before inferior step (when GDB record the running message, inferior
    only can step), GDB will call this function to record the values to
    record_full_list.  This function will call gdbarch_process_record to
@@ -785,10 +1007,7 @@ record_full_message (struct regcache *regcache, enum gdb_signal signal)
   record_full_arch_list_head->prev = record_full_list;
   record_full_list = record_full_arch_list_tail;
 
-  if (record_full_insn_num == record_full_insn_max_num)
-    record_full_list_release_first ();
-  else
-    record_full_insn_num++;
+  record_full_trim_log ();
 }
 
 static bool
@@ -908,6 +1127,298 @@ record_full_exec_insn (struct regcache *regcache,
     }
 }
 
+/* The size of the blocks of memory held by a record_full_replay_cache.  */
+
+#define RECORD_FULL_REPLAY_PAGE_SIZE 4096
+
+/* Replaying an instruction swaps the values saved in its log entries
+   with the current registers and memory.  Doing that through the
+   regcache and the target costs a register or memory transfer to the
+   target beneath for each entry, which makes replaying long stretches
+   of the log slow.
+
+   A record_full_replay_cache instead holds a copy of the registers and
+   of the pages of memory touched while replaying, applies the entries
+   to that copy, and writes the changed state back only once, when
+   flushed.  */
+
+class record_full_replay_cache
+{
+public:
+  explicit record_full_replay_cache (struct regcache *regcache)
+    : m_regcache (regcache),
+      m_gdbarch (regcache->arch ()),
+      m_regs (gdbarch_num_regs (m_gdbarch)),
+      m_dirty_regs (gdbarch_num_regs (m_gdbarch))
+  {
+  }
+
+  DISABLE_COPY_AND_ASSIGN (record_full_replay_cache);
+
+  /* Execute ENTRY, like record_full_exec_insn.  */
+  void exec_insn (struct record_full_entry *entry);
+
+  /* Return the current value of the PC.  */
+  CORE_ADDR read_pc ();
+
+  /* Write the changed registers and memory back to the target.  This
+     must be called before the state is looked at by anything else.  */
+  void flush ();
+
+private:
+  struct page
+  {
+    gdb::byte_vector data;
+
+    /* The range of DATA that was changed since it was read.  */
+    size_t dirty_begin = RECORD_FULL_REPLAY_PAGE_SIZE;
+    size_t dirty_end = 0;
+  };
+
+  /* Return the copy of register REGNUM, reading it if needed, or
+     nullptr if the register can't be held here.  */
+  gdb_byte *reg (int regnum);
+
+  /* Return the copy of the page starting at BASE, reading it if
+     needed, or nullptr if it can't be read as a whole.  */
+  page *get_page (CORE_ADDR base);
+
+  /* Write the page starting at BASE back to the target if it was
+     changed.  */
+  void flush_page (CORE_ADDR base, page &p);
+
+  /* Write the changed registers back to the regcache, and forget
+     about all the registers.  */
+  void flush_registers ();
+
+  struct regcache *m_regcache;
+  struct gdbarch *m_gdbarch;
+
+  /* The copies of the raw registers, indexed by register number.
+     Registers that were not used yet are empty.  */
+  std::vector<gdb::byte_vector> m_regs;
+
+  /* Whether the copy of each register was changed since it was read.
+     Registers that were only read, like the PC by read_pc, are not
+     written back.  */
+  std::vector<bool> m_dirty_regs;
+
+  /* The copies of memory, indexed by the start of the page.  */
+  gdb::unordered_map<CORE_ADDR, page> m_pages;
+
+  /* Pages that could not be read as a whole.  Entries touching them
+     are executed directly on the target.  */
+  gdb::unordered_set<CORE_ADDR> m_unreadable_pages;
+};
+
+gdb_byte *
+record_full_replay_cache::reg (int regnum)
+{
+  if (regnum >= m_regs.size ()
+      || gdbarch_cannot_store_register (m_gdbarch, regnum))
+    return nullptr;
+
+  gdb::byte_vector &buf = m_regs[regnum];
+  if (buf.empty ())
+    {
+      gdb::byte_vector tmp (register_size (m_gdbarch, regnum));
+
+      if (m_regcache->raw_read (regnum, tmp.data ()) != REG_VALID)
+	return nullptr;
+      buf = std::move (tmp);
+    }
+
+  return buf.data ();
+}
+
+record_full_replay_cache::page *
+record_full_replay_cache::get_page (CORE_ADDR base)
+{
+  auto it = m_pages.find (base);
+  if (it != m_pages.end ())
+    return &it->second;
+
+  if (m_unreadable_pages.contains (base))
+    return nullptr;
+
+  page p;
+  p.data.resize (RECORD_FULL_REPLAY_PAGE_SIZE);
+  if (target_read_memory (base, p.data.data (),
+			  RECORD_FULL_REPLAY_PAGE_SIZE) != 0)
+    {
+      m_unreadable_pages.insert (base);
+      return nullptr;
+    }
+
+  return &m_pages.emplace (base, std::move (p)).first->second;
+}
+
+void
+record_full_replay_cache::flush_page (CORE_ADDR base, page &p)
+{
+  if (p.dirty_begin >= p.dirty_end)
+    return;
+
+  CORE_ADDR addr = base + p.dirty_begin;
+  ssize_t len = p.dirty_end - p.dirty_begin;
+
+  if (target_write_memory (addr, p.data.data () + p.dirty_begin, len)
+      && record_debug)
+    warning (_("Process record: error writing memory at "
+	       "addr = %s len = %zd."),
+	     paddress (m_gdbarch, addr), len);
+
+  p.dirty_begin = RECORD_FULL_REPLAY_PAGE_SIZE;
+  p.dirty_end = 0;
+}
+
+void
+record_full_replay_cache::flush_registers ()
+{
+  for (int regnum = 0; regnum < m_regs.size (); ++regnum)
+    if (!m_regs[regnum].empty ())
+      {
+	if (m_dirty_regs[regnum])
+	  m_regcache->raw_write (regnum, m_regs[regnum]);
+	m_regs[regnum].clear ();
+	m_dirty_regs[regnum] = false;
+      }
+}
+
+void
+record_full_replay_cache::flush ()
+{
+  flush_registers ();
+  for (auto &[base, p] : m_pages)
+    flush_page (base, p);
+}
+
+CORE_ADDR
+record_full_replay_cache::read_pc ()
+{
+  int pc_regnum = gdbarch_pc_regnum (m_gdbarch);
+
+  if (!gdbarch_read_pc_p (m_gdbarch) && pc_regnum >= 0)
+    {
+      const gdb_byte *buf = reg (pc_regnum);
+
+      if (buf != nullptr)
+	{
+	  ULONGEST raw_val
+	    = extract_unsigned_integer (buf,
+					register_size (m_gdbarch, pc_regnum),
+					gdbarch_byte_order (m_gdbarch));
+
+	  return gdbarch_addr_bits_remove (m_gdbarch, raw_val);
+	}
+    }
+
+  flush_registers ();
+  return regcache_read_pc (m_regcache);
+}
+
+void
+record_full_replay_cache::exec_insn (struct record_full_entry *entry)
+{
+  switch (entry->type)
+    {
+    case record_full_reg:
+      {
+	gdb_byte *buf = reg (entry->u.reg.num);
+
+	if (buf == nullptr)
+	  {
+	    /* This register can't be held here, e.g. because it is a
+	       pseudo register overlapping the raw registers.  */
+	    flush_registers ();
+	    record_full_exec_insn (m_regcache, m_gdbarch, entry);
+	    return;
+	  }
+
+	if (record_debug > 1)
+	  gdb_printf (gdb_stdlog,
+		      "Process record: record_full_reg %s to "
+		      "inferior num = %d.\n",
+		      host_address_to_string (entry),
+		      entry->u.reg.num);
+
+	std::swap_ranges (buf, buf + entry->u.reg.len,
+			  record_full_get_loc (entry));
+	m_dirty_regs[entry->u.reg.num] = true;
+      }
+      break;
+
+    case record_full_mem:
+      {
+	if (entry->u.mem.mem_entry_not_accessible)
+	  return;
+
+	CORE_ADDR addr = entry->u.mem.addr;
+	CORE_ADDR first = align_down (addr, RECORD_FULL_REPLAY_PAGE_SIZE);
+	CORE_ADDR last = align_down (addr + entry->u.mem.len - 1,
+				     RECORD_FULL_REPLAY_PAGE_SIZE);
+	bool cached = last >= first;
+
+	for (CORE_ADDR base = first;
+	     cached && base >= first && base <= last;
+	     base += RECORD_FULL_REPLAY_PAGE_SIZE)
+	  cached = get_page (base) != nullptr;
+
+	if (!cached)
+	  {
+	    /* Execute the entry on the target, after writing back and
+	       forgetting the pages it overlaps.  */
+	    for (CORE_ADDR base = first;
+		 base >= first && base <= last;
+		 base += RECORD_FULL_REPLAY_PAGE_SIZE)
+	      {
+		auto it = m_pages.find (base);
+		if (it != m_pages.end ())
+		  {
+		    flush_page (base, it->second);
+		    m_pages.erase (it);
+		  }
+	      }
+
+	    record_full_exec_insn (m_regcache, m_gdbarch, entry);
+	    return;
+	  }
+
+	if (record_debug > 1)
+	  gdb_printf (gdb_stdlog,
+		      "Process record: record_full_mem %s to "
+		      "inferior addr = %s len = %d.\n",
+		      host_address_to_string (entry),
+		      paddress (m_gdbarch, addr), entry->u.mem.len);
+
+	gdb_byte *loc = record_full_get_loc (entry);
+	int done = 0;
+	while (done < entry->u.mem.len)
+	  {
+	    CORE_ADDR base = align_down (addr + done,
+					 RECORD_FULL_REPLAY_PAGE_SIZE);
+	    size_t offset = addr + done - base;
+	    size_t n = std::min<size_t> (RECORD_FULL_REPLAY_PAGE_SIZE - offset,
+					 entry->u.mem.len - done);
+	    page *p = get_page (base);
+
+	    std::swap_ranges (loc + done, loc + done + n,
+			      p->data.data () + offset);
+	    p->dirty_begin = std::min (p->dirty_begin, offset);
+	    p->dirty_end = std::max (p->dirty_end, offset + n);
+	    done += n;
+	  }
+
+	/* We've changed memory --- check if a hardware watchpoint
+	   should trap.  See record_full_exec_insn.  */
+	if (hardware_watchpoint_inserted_in_range
+	    (current_inferior ()->aspace.get (), addr, entry->u.mem.len))
+	  record_full_stop_reason = TARGET_STOPPED_BY_WATCHPOINT;
+      }
+      break;
+    }
+}
+
 static void record_full_restore (void);
 
 /* Asynchronous signal handle registered as event loop source for when
@@ -1309,6 +1820,7 @@ record_full_wait_1 (struct target_ops *ops,
       const address_space *aspace = current_inferior ()->aspace.get ();
       int continue_flag = 1;
       int first_record_full_end = 1;
+      record_full_replay_cache replay_cache (regcache);
 
       try
 	{
@@ -1364,7 +1876,7 @@ record_full_wait_1 (struct target_ops *ops,
 		  break;
 		}
 
-	      record_full_exec_insn (regcache, gdbarch, record_full_list);
+	      replay_cache.exec_insn (record_full_list);
 
 	      if (record_full_list->type == record_full_end)
 		{
@@ -1399,7 +1911,7 @@ record_full_wait_1 (struct target_ops *ops,
 			}
 
 		      /* check breakpoint */
-		      tmp_pc = regcache_read_pc (regcache);
+		      tmp_pc = replay_cache.read_pc ();
 		      if (record_check_stopped_by_breakpoint
 			  (aspace, tmp_pc, &record_full_stop_reason))
 			{
@@ -1444,6 +1956,8 @@ record_full_wait_1 (struct target_ops *ops,
 	    }
 	  while (continue_flag);
 
+	  replay_cache.flush ();
+
 	replay_out:
 	  if (status->kind () == TARGET_WAITKIND_STOPPED)
 	    {
@@ -1458,6 +1972,8 @@ record_full_wait_1 (struct target_ops *ops,
 	}
       catch (const gdb_exception &ex)
 	{
+	  replay_cache.flush ();
+
 	  if (execution_direction == EXEC_REVERSE)
 	    {
 	      if (record_full_list->next)
@@ -1585,10 +2101,7 @@ record_full_registers_change (struct regcache *regcache, int regnum)
   record_full_arch_list_head->prev = record_full_list;
   record_full_list = record_full_arch_list_tail;
 
-  if (record_full_insn_num == record_full_insn_max_num)
-    record_full_list_release_first ();
-  else
-    record_full_insn_num++;
+  record_full_trim_log ();
 }
 
 /* "store_registers" method for process record target.  */
@@ -1701,10 +2214,7 @@ record_full_target::xfer_partial (enum target_object object,
       record_full_arch_list_head->prev = record_full_list;
       record_full_list = record_full_arch_list_tail;
 
-      if (record_full_insn_num == record_full_insn_max_num)
-	record_full_list_release_first ();
-      else
-	record_full_insn_num++;
+      record_full_trim_log ();
     }
 
   return this->beneath ()->xfer_partial (object, annex, readbuf, writebuf,
@@ -1950,6 +2460,13 @@ record_full_base_target::info_record ()
       /* Display log count.  */
       gdb_printf (_("Log contains %u instructions.\n"),
 		  record_full_insn_num);
+
+      /* Display log size.  */
+      if (record_full_insn_num > 0)
+	gdb_printf (_("Log uses %s bytes (%s bytes per instruction).\n"),
+		    pulongest (record_full_log_size ()),
+		    pulongest (record_full_log_size ()
+			       / record_full_insn_num));
     }
   else
     gdb_printf (_("No instructions have been logged.\n"));
@@ -1957,6 +2474,9 @@ record_full_base_target::info_record ()
   /* Display max log size.  */
   gdb_printf (_("Max logged instructions is %u.\n"),
 	      record_full_insn_max_num);
+  if (record_full_memory_max != UINT_MAX)
+    gdb_printf (_("Max log size is %u bytes.\n"),
+		record_full_memory_max);
 }
 
 bool
@@ -2753,7 +3273,7 @@ record_full_goto_insn (struct record_full_entry *entry,
   scoped_restore restore_operation_disable
     = record_full_gdb_operation_disable_set ();
   regcache *regcache = get_thread_regcache (inferior_thread ());
-  struct gdbarch *gdbarch = regcache->arch ();
+  record_full_replay_cache replay_cache (regcache);
 
   /* Assume everything is valid: we will hit the entry,
      and we will not hit the end of the recording.  */
@@ -2761,14 +3281,24 @@ record_full_goto_insn (struct record_full_entry *entry,
   if (dir == EXEC_FORWARD)
     record_full_list = record_full_list->next;
 
-  do
+  try
     {
-      record_full_exec_insn (regcache, gdbarch, record_full_list);
-      if (dir == EXEC_REVERSE)
-	record_full_list = record_full_list->prev;
-      else
-	record_full_list = record_full_list->next;
-    } while (record_full_list != entry);
+      do
+	{
+	  replay_cache.exec_insn (record_full_list);
+	  if (dir == EXEC_REVERSE)
+	    record_full_list = record_full_list->prev;
+	  else
+	    record_full_list = record_full_list->next;
+	} while (record_full_list != entry);
+    }
+  catch (const gdb_exception &ex)
+    {
+      replay_cache.flush ();
+      throw;
+    }
+
+  replay_cache.flush ();
 }
 
 /* Alias for "target record-full".  */
@@ -2794,6 +3324,34 @@ set_record_full_insn_max_num (const char *args, int from_tty,
     }
 }
 
+/* The "set record full memory-max" command.  */
+
+static void
+set_record_full_memory_max (const char *args, int from_tty,
+			    struct cmd_list_element *c)
+{
+  /* Keep at least the last instruction, as in record_full_trim_log.  */
+  while (record_full_insn_num > 1 && record_full_log_over_memory_max ())
+    {
+      record_full_list_release_first ();
+      record_full_insn_num--;
+    }
+}
+
+/* The "show record full memory-max" command.  */
+
+static void
+show_record_full_memory_max (struct ui_file *file, int from_tty,
+			     struct cmd_list_element *c, const char *value)
+{
+  if (record_full_memory_max == UINT_MAX)
+    gdb_printf (file, _("Record/replay buffer memory limit is %s.\n"),
+		value);
+  else
+    gdb_printf (file, _("Record/replay buffer memory limit is %s bytes.\n"),
+		value);
+}
+
 /* Implement the 'maintenance print record-instruction' command.  */
 
 static void
@@ -2959,6 +3517,19 @@ limit.  Default is 200000."),
 		     no_class, 1, &show_record_cmdlist);
   deprecate_cmd (c, "show record full insn-number-max");
 
+  add_setshow_uinteger_cmd ("memory-max", no_class,
+			    &record_full_memory_max,
+			    _("Set record/replay buffer memory limit."),
+			    _("Show record/replay buffer memory limit."), _("\
+Set the maximum number of bytes of memory used by the record/replay\n\
+buffer.  The buffer is allocated in blocks of 64 KiB, which count\n\
+whole.  A value of either \"unlimited\" or zero means no limit.\n\
+Default is unlimited."),
+			    set_record_full_memory_max,
+			    show_record_full_memory_max,
+			    &set_record_full_cmdlist,
+			    &show_record_full_cmdlist);
+
   set_show_commands record_full_memory_query_cmds
     = add_setshow_boolean_cmd ("memory-query", no_class,
 			       &record_full_memory_query, _("\
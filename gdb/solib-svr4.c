@@ -45,6 +45,7 @@
 #include "gdb_bfd.h"
 #include "probe.h"
 
+#include <chrono>
 #include <map>
 
 static void svr4_relocate_main_executable (void);
@@ -2229,6 +2230,9 @@ svr4_solib_ops::handle_event () const
        sufficient.  */
   }
 
+  using namespace std::chrono;
+  steady_clock::time_point start_time = steady_clock::now ();
+
   if (action == UPDATE_OR_RELOAD)
     {
       if (!this->update_incremental (info, debug_base, lm))
@@ -2238,6 +2242,17 @@ svr4_solib_ops::handle_event () const
   if (action == FULL_RELOAD)
     this->update_full (info);
 
+  if (debug_solib)
+    {
+      auto us = duration_cast<microseconds> (steady_clock::now ()
+					     - start_time);
+
+      solib_debug_printf ("%s update of namespace %s took %ld us",
+			  action == FULL_RELOAD ? "full" : "incremental",
+			  paddress (current_inferior ()->arch (), debug_base),
+			  (long) us.count ());
+    }
+
   cleanup.release ();
 }
 
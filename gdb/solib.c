@@ -19,6 +19,7 @@
 
 
 #include <fcntl.h>
+#include <chrono>
 #include "exceptions.h"
 #include "extract-store-integer.h"
 #include "symtab.h"
@@ -764,14 +765,21 @@ update_solib_list (int from_tty)
      we remove it from the inferior's list.  If it doesn't, the
      inferior has unloaded it, and we remove it from GDB's list.  By
      the time we're done walking GDB's list, the inferior's list
-     contains only the new shared objects, which we then add.  */
+     contains only the new shared objects, which we then add.
+
+     Both lists are normally in the same order, so the search for each
+     of GDB's shared objects starts just after the previous match.
+     This keeps the common case, where few objects were loaded or
+     unloaded, linear rather than quadratic in the number of shared
+     objects.  */
 
   owning_intrusive_list<solib> inferior = ops->current_sos ();
   owning_intrusive_list<solib>::iterator gdb_iter
     = current_program_space->solibs ().begin ();
+  intrusive_list<solib>::iterator hint = inferior.begin ();
   while (gdb_iter != current_program_space->solibs ().end ())
     {
-      intrusive_list<solib>::iterator inferior_iter = inferior.begin ();
+      intrusive_list<solib>::iterator inferior_iter = hint;
 
       /* Check to see whether the shared object *gdb also appears in
 	 the inferior's current list.  */
@@ -779,12 +787,24 @@ update_solib_list (int from_tty)
 	if (ops->same (*gdb_iter, *inferior_iter))
 	  break;
 
+      if (inferior_iter == inferior.end ())
+	{
+	  for (inferior_iter = inferior.begin ();
+	       inferior_iter != hint;
+	       ++inferior_iter)
+	    if (ops->same (*gdb_iter, *inferior_iter))
+	      break;
+
+	  if (inferior_iter == hint)
+	    inferior_iter = inferior.end ();
+	}
+
       /* If the shared object appears on the inferior's list too, then
 	 it's still loaded, so we don't need to do anything.  Delete
 	 it from the inferior's list, and leave it on GDB's list.  */
       if (inferior_iter != inferior.end ())
 	{
-	  inferior.erase (inferior_iter);
+	  hint = inferior.erase (inferior_iter);
 	  ++gdb_iter;
 	}
 
@@ -946,8 +966,15 @@ solib_add (const char *pattern, int from_tty, int readsyms)
 	error (_ ("Invalid regexp: %s"), re_err);
     }
 
+  using namespace std::chrono;
+  steady_clock::time_point start_time = steady_clock::now ();
+  size_t num_added = current_program_space->added_solibs.size ();
+  size_t num_deleted = current_program_space->deleted_solibs.size ();
+
   update_solib_list (from_tty);
 
+  steady_clock::time_point update_time = steady_clock::now ();
+
   /* Walk the list of currently loaded shared libraries, and read
      symbols for any that match the pattern --- or any whose symbols
      aren't already loaded, if no pattern was given.  */
@@ -986,9 +1013,30 @@ solib_add (const char *pattern, int from_tty, int readsyms)
 	    }
 	}
 
+    steady_clock::time_point symbols_time = steady_clock::now ();
+
     if (loaded_any_symbols || !current_program_space->deleted_solibs.empty ())
       breakpoint_re_set ();
 
+    if (debug_solib)
+      {
+	steady_clock::time_point end_time = steady_clock::now ();
+	auto ms = [] (steady_clock::duration d)
+	  {
+	    return (long) duration_cast<milliseconds> (d).count ();
+	  };
+
+	solib_debug_printf ("added %zu, removed %zu; list update %ld ms, "
+			    "symbols %ld ms, breakpoints %ld ms",
+			    (current_program_space->added_solibs.size ()
+			     - num_added),
+			    (current_program_space->deleted_solibs.size ()
+			     - num_deleted),
+			    ms (update_time - start_time),
+			    ms (symbols_time - update_time),
+			    ms (end_time - symbols_time));
+      }
+
     if (from_tty && pattern && !any_matches)
       gdb_printf ("No loaded shared libraries match the pattern `%s'.\n",
 		  pattern);
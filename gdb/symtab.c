@@ -75,6 +75,7 @@
 #include "gdbsupport/common-utils.h"
 #include <optional>
 #include "gdbsupport/unordered_set.h"
+#include "trigram-index.h"
 
 /* Forward declarations for local functions.  */
 
@@ -190,6 +191,10 @@ struct symbol_cache_slot
 {
   enum symbol_cache_slot_state state;
 
+  /* The generation of the cache when this slot was filled in.  A slot
+     from an older generation is treated as unused.  */
+  unsigned int generation;
+
   /* The objfile that was current when the symbol was looked up.
      This is only needed for global blocks, but for simplicity's sake
      we allocate the space for both.  If data shows the extra space used
@@ -238,6 +243,11 @@ struct block_symbol_cache
   unsigned int misses;
   unsigned int collisions;
 
+  /* The current generation of the cache.  Flushing the cache just
+     increments this, which invalidates all the slots at once without
+     having to visit them.  */
+  unsigned int generation;
+
   /* SYMBOLS is a variable length array of this size.
      One can imagine that in general one cache (global/static) should be a
      fraction of the size of the other, but there's no data at the moment
@@ -247,6 +257,17 @@ struct block_symbol_cache
   struct symbol_cache_slot symbols[1];
 };
 
+/* Return true if SLOT of BSC holds an entry of the current
+   generation.  */
+
+static bool
+symbol_cache_slot_live (const struct block_symbol_cache *bsc,
+			const struct symbol_cache_slot *slot)
+{
+  return (slot->state != SYMBOL_SLOT_UNUSED
+	  && slot->generation == bsc->generation);
+}
+
 /* Clear all slots of BSC and free BSC.  */
 
 static void
@@ -288,6 +309,92 @@ struct symbol_cache
 
 static const registry<program_space>::key<symbol_cache> symbol_cache_key;
 
+/* The maximum number of failed lookups remembered per objfile.  */
+#define MAX_OBJFILE_SYMBOL_MISSES 1024
+
+/* Lookups of global or static symbols that found nothing in a
+   particular objfile.
+
+   The set of symbols an objfile provides only changes when its symbols
+   are (re-)read, so unlike the program space's symbol cache, which is
+   flushed whenever any objfile comes or goes, this record survives
+   other objfiles being added or removed.  After a shared library is
+   loaded, refilling the symbol cache then only needs to search the
+   objfiles that weren't already known to lack the name, rather than
+   querying the quick symbol functions of every objfile again.  */
+
+struct objfile_symbol_misses
+{
+  struct entry
+  {
+    std::string name;
+    domain_search_flags domain;
+    enum block_enum block;
+  };
+
+  /* The type used when searching.  */
+  struct entry_search
+  {
+    const char *name;
+    domain_search_flags domain;
+    enum block_enum block;
+  };
+
+  struct entry_hash
+  {
+    using is_transparent = void;
+
+    template<typename T>
+    uint64_t operator() (const T &e) const noexcept
+    {
+      return (ankerl::unordered_dense::hash<std::string_view> () (e.name)
+	      + e.domain * 7 + e.block);
+    }
+  };
+
+  struct entry_eq
+  {
+    using is_transparent = void;
+
+    template<typename T>
+    bool operator() (const T &lhs, const entry &rhs) const noexcept
+    {
+      return (lhs.block == rhs.block && lhs.domain == rhs.domain
+	      && lhs.name == rhs.name);
+    }
+  };
+
+  /* Return true if looking up NAME in DOMAIN in the BLOCK block of the
+     objfile is known to fail.  */
+  bool contains (const char *name, domain_search_flags domain,
+		 enum block_enum block) const
+  {
+    return misses.contains (entry_search {name, domain, block});
+  }
+
+  /* Record that looking up NAME in DOMAIN in the BLOCK block of the
+     objfile failed.  */
+  void add (const char *name, domain_search_flags domain,
+	    enum block_enum block)
+  {
+    if (misses.size () >= MAX_OBJFILE_SYMBOL_MISSES)
+      misses.clear ();
+    misses.insert (entry {name, domain, block});
+  }
+
+  gdb::unordered_set<entry, entry_hash, entry_eq> misses;
+};
+
+/* Objfile key for the failed lookups in that objfile.  */
+
+static const registry<objfile>::key<objfile_symbol_misses>
+  objfile_symbol_misses_key;
+
+/* The number of objfile searches avoided thanks to the per-objfile
+   records of failed lookups.  */
+
+static unsigned int objfile_symbol_misses_hits;
+
 /* When non-zero, print debugging messages related to symtab creation.  */
 unsigned int symtab_create_debug = 0;
 
@@ -1473,7 +1580,8 @@ symbol_cache_lookup (struct symbol_cache *cache,
   *bsc_ptr = bsc;
   *slot_ptr = slot;
 
-  if (eq_symbol_entry (slot, objfile_context, name, domain))
+  if (symbol_cache_slot_live (bsc, slot)
+      && eq_symbol_entry (slot, objfile_context, name, domain))
     {
       symbol_lookup_debug_printf ("%s block symbol cache hit%s for %s, %s",
 				  block == GLOBAL_BLOCK ? "Global" : "Static",
@@ -1512,9 +1620,11 @@ symbol_cache_mark_found (struct block_symbol_cache *bsc,
     return;
   if (slot->state != SYMBOL_SLOT_UNUSED)
     {
-      ++bsc->collisions;
+      if (symbol_cache_slot_live (bsc, slot))
+	++bsc->collisions;
       symbol_cache_clear_slot (slot);
     }
+  slot->generation = bsc->generation;
   slot->state = SYMBOL_SLOT_FOUND;
   slot->objfile_context = objfile_context;
   slot->value.found.symbol = symbol;
@@ -1536,9 +1646,11 @@ symbol_cache_mark_not_found (struct block_symbol_cache *bsc,
     return;
   if (slot->state != SYMBOL_SLOT_UNUSED)
     {
-      ++bsc->collisions;
+      if (symbol_cache_slot_live (bsc, slot))
+	++bsc->collisions;
       symbol_cache_clear_slot (slot);
     }
+  slot->generation = bsc->generation;
   slot->state = SYMBOL_SLOT_NOT_FOUND;
   slot->objfile_context = objfile_context;
   slot->value.name = xstrdup (name);
@@ -1552,7 +1664,6 @@ symbol_cache_flush (struct program_space *pspace)
 {
   ada_clear_symbol_cache (pspace);
   struct symbol_cache *cache = symbol_cache_key.get (pspace);
-  int pass;
 
   if (cache == NULL)
     return;
@@ -1563,9 +1674,8 @@ symbol_cache_flush (struct program_space *pspace)
       return;
     }
 
-  /* If the cache is untouched since the last flush, early exit.
-     This is important for performance during the startup of a program linked
-     with 100s (or 1000s) of shared libraries.  */
+  /* If the cache is untouched since the last flush, there can't be any
+     slots of the current generation, so there is nothing to do.  */
   if (cache->global_symbols->misses == 0
       && cache->static_symbols->misses == 0)
     return;
@@ -1573,14 +1683,21 @@ symbol_cache_flush (struct program_space *pspace)
   gdb_assert (cache->global_symbols->size == symbol_cache_size);
   gdb_assert (cache->static_symbols->size == symbol_cache_size);
 
-  for (pass = 0; pass < 2; ++pass)
+  /* Starting a new generation invalidates all the slots.  This is
+     important for performance during the startup of a program linked
+     with 100s (or 1000s) of shared libraries, as the cache is flushed
+     for each of them.  Stale slots are only really cleared when they
+     are reused, or if the generation number wraps around.  */
+  for (int pass = 0; pass < 2; ++pass)
     {
       struct block_symbol_cache *bsc
 	= pass == 0 ? cache->global_symbols : cache->static_symbols;
-      unsigned int i;
 
-      for (i = 0; i < bsc->size; ++i)
-	symbol_cache_clear_slot (&bsc->symbols[i]);
+      if (++bsc->generation == 0)
+	{
+	  for (unsigned int i = 0; i < bsc->size; ++i)
+	    symbol_cache_clear_slot (&bsc->symbols[i]);
+	}
     }
 
   cache->global_symbols->hits = 0;
@@ -1621,6 +1738,9 @@ symbol_cache_dump (const struct symbol_cache *cache)
 
 	  QUIT;
 
+	  if (!symbol_cache_slot_live (bsc, slot))
+	    continue;
+
 	  switch (slot->state)
 	    {
 	    case SYMBOL_SLOT_UNUSED:
@@ -1679,7 +1799,12 @@ maintenance_flush_symbol_cache (const char *args, int from_tty)
   for (struct program_space *pspace : program_spaces)
     {
       symbol_cache_flush (pspace);
+
+      for (objfile *objfile : pspace->objfiles ())
+	objfile_symbol_misses_key.clear (objfile);
     }
+
+  objfile_symbol_misses_hits = 0;
 }
 
 /* Print usage statistics of CACHE.  */
@@ -1711,6 +1836,7 @@ symbol_cache_stats (struct symbol_cache *cache)
       gdb_printf ("  hits:       %u\n", bsc->hits);
       gdb_printf ("  misses:     %u\n", bsc->misses);
       gdb_printf ("  collisions: %u\n", bsc->collisions);
+      gdb_printf ("  generation: %u\n", bsc->generation);
     }
 }
 
@@ -1736,6 +1862,9 @@ maintenance_print_symbol_cache_statistics (const char *args, int from_tty)
       else
 	symbol_cache_stats (cache);
     }
+
+  gdb_printf (_("Objfile searches skipped due to earlier misses: %u\n"),
+	      objfile_symbol_misses_hits);
 }
 
 /* This module's 'new_objfile' observer.  */
@@ -1744,6 +1873,10 @@ static void
 symtab_new_objfile_observer (struct objfile *objfile)
 {
   symbol_cache_flush (objfile->pspace ());
+
+  /* The objfile's symbols have just been (re-)read, so lookups that
+     failed while they were being read may now succeed.  */
+  objfile_symbol_misses_key.clear (objfile);
 }
 
 /* This module's 'all_objfiles_removed' observer.  */
@@ -2600,6 +2733,15 @@ lookup_symbol_in_objfile (struct objfile *objfile, enum block_enum block_index,
 			      ? "GLOBAL_BLOCK" : "STATIC_BLOCK",
 			      name, domain_name (domain).c_str ());
 
+  objfile_symbol_misses *misses = objfile_symbol_misses_key.get (objfile);
+  if (misses != nullptr && misses->contains (name, domain, block_index))
+    {
+      ++objfile_symbol_misses_hits;
+      symbol_lookup_debug_printf
+	("lookup_symbol_in_objfile (...) = NULL (known miss)");
+      return {};
+    }
+
   result = lookup_symbol_in_objfile_symtabs (objfile, block_index,
 					     name, domain);
   if (result.symbol != NULL)
@@ -2612,6 +2754,12 @@ lookup_symbol_in_objfile (struct objfile *objfile, enum block_enum block_index,
 
   result = lookup_symbol_via_quick_fns (objfile, block_index,
 					name, domain);
+  if (result.symbol == nullptr)
+    {
+      if (misses == nullptr)
+	misses = objfile_symbol_misses_key.emplace (objfile);
+      misses->add (name, domain, block_index);
+    }
   symbol_lookup_debug_printf ("lookup_symbol_in_objfile (...) = %s%s",
 			      result.symbol != NULL
 			      ? host_address_to_string (result.symbol)
@@ -4889,11 +5037,127 @@ global_symbol_searcher::is_suitable_msymbol
     }
 }
 
+/* When true, regexp searches of minimal symbols use a trigram index
+   of their names.  The index is built on first use, per objfile.  */
+
+static bool symbol_search_index = false;
+
+/* A trigram index over the names of the minimal symbols of an
+   objfile.  */
+
+struct msymbol_trigram_index
+{
+  /* The minimal symbols the index was built for; if the objfile's
+     minimal symbols are replaced, the index is rebuilt.  COUNT is -1
+     while the index is being built.  */
+  const minimal_symbol *msymbols = nullptr;
+  int count = -1;
+
+  trigram_index index;
+};
+
+/* Objfile key for the minimal symbol trigram index.  */
+
+static const registry<objfile>::key<msymbol_trigram_index>
+  msymbol_trigram_index_key;
+
+/* Return the trigram index of the minimal symbols of OBJFILE, building
+   it if needed.  */
+
+static const trigram_index &
+get_msymbol_trigram_index (objfile *objfile)
+{
+  msymbol_trigram_index *idx = msymbol_trigram_index_key.get (objfile);
+  const minimal_symbol *msymbols = objfile->per_bfd->msymbols.get ();
+  int count = objfile->per_bfd->minimal_symbol_count;
+
+  if (idx != nullptr && idx->msymbols == msymbols && idx->count == count)
+    return idx->index;
+
+  msymbol_trigram_index_key.clear (objfile);
+  idx = msymbol_trigram_index_key.emplace (objfile);
+
+  for (int i = 0; i < count; ++i)
+    {
+      QUIT;
+      idx->index.add (msymbols[i].natural_name (), i);
+    }
+  idx->index.shrink_to_fit ();
+
+  idx->msymbols = msymbols;
+  idx->count = count;
+
+  symtab_create_debug_printf ("built trigram index for %d minimal symbols of"
+			      " %s, %zu bytes", count,
+			      objfile_debug_name (objfile),
+			      idx->index.memory_used ());
+  return idx->index;
+}
+
+/* Call CALLBACK for each minimal symbol of OBJFILE whose name may
+   contain all of LITERALS.  Stop early and return false if CALLBACK
+   returns false, otherwise return true.  */
+
+static bool
+iterate_over_candidate_msymbols
+  (objfile *objfile, const std::vector<std::string> &literals,
+   gdb::function_view<bool (minimal_symbol *)> callback)
+{
+  if (symbol_search_index && !literals.empty ())
+    {
+      std::optional<std::vector<unsigned int>> candidates
+	= get_msymbol_trigram_index (objfile).candidates (literals);
+
+      if (candidates.has_value ())
+	{
+	  minimal_symbol *msymbols = objfile->per_bfd->msymbols.get ();
+
+	  for (unsigned int i : *candidates)
+	    if (!callback (&msymbols[i]))
+	      return false;
+	  return true;
+	}
+    }
+
+  for (minimal_symbol *msymbol : objfile->msymbols ())
+    if (!callback (msymbol))
+      return false;
+  return true;
+}
+
+/* Called when "maint set symbol-search-index" is used.  */
+
+static void
+set_symbol_search_index (const char *args, int from_tty,
+			 struct cmd_list_element *c)
+{
+  if (!symbol_search_index)
+    for (struct program_space *pspace : program_spaces)
+      for (objfile *objfile : pspace->objfiles ())
+	msymbol_trigram_index_key.clear (objfile);
+}
+
+/* See symtab.h.  */
+
+bool
+global_symbol_searcher::name_matcher::matches (const char *name) const
+{
+  if (!regex.has_value ())
+    return true;
+
+  /* Checking for the literals is much cheaper than running the regexp,
+     and rejects most names.  */
+  if (!contains_all_literals (name, literals))
+    return false;
+
+  return regex->exec (name, 0, nullptr, 0) == 0;
+}
+
 /* See symtab.h.  */
 
 bool
 global_symbol_searcher::expand_symtabs
-	(objfile *objfile, const std::optional<compiled_regex> &preg) const
+	(objfile *objfile, const name_matcher &preg) const
 {
   domain_search_flags kind = m_kind;
   bool found_msymbol = false;
@@ -4911,8 +5175,7 @@ global_symbol_searcher::expand_symtabs
      &lookup_name_info::match_any (),
      [&] (const char *symname)
      {
-       return (!preg.has_value ()
-	       || preg->exec (symname, 0, NULL, 0) == 0);
+       return preg.matches (symname);
      },
      NULL,
      SEARCH_GLOBAL_BLOCK | SEARCH_STATIC_BLOCK,
@@ -4934,37 +5197,34 @@ global_symbol_searcher::expand_symtabs
      objfiles is not worth the pain.  */
   if (m_filenames.empty ()
       && (kind & (SEARCH_VAR_DOMAIN | SEARCH_FUNCTION_DOMAIN)) != 0)
-    {
-      for (minimal_symbol *msymbol : objfile->msymbols ())
+    iterate_over_candidate_msymbols
+      (objfile, preg.literals, [&] (minimal_symbol *msymbol)
 	{
 	  QUIT;
 
 	  if (msymbol->created_by_gdb)
-	    continue;
+	    return true;
 
-	  if (is_suitable_msymbol (kind, msymbol))
+	  if (is_suitable_msymbol (kind, msymbol)
+	      && preg.matches (msymbol->natural_name ()))
 	    {
-	      if (!preg.has_value ()
-		  || preg->exec (msymbol->natural_name (), 0,
-				 NULL, 0) == 0)
-		{
-		  /* An important side-effect of these lookup functions is
-		     to expand the symbol table if msymbol is found, later
-		     in the process we will add matching symbols or
-		     msymbols to the results list, and that requires that
-		     the symbols tables are expanded.  */
-		  if ((kind & SEARCH_FUNCTION_DOMAIN) != 0
-		      ? (find_pc_compunit_symtab
-			 (msymbol->value_address (objfile)) == NULL)
-		      : (lookup_symbol_in_objfile_from_linkage_name
-			 (objfile, msymbol->linkage_name (),
-			  SEARCH_VFT)
-			 .symbol == NULL))
-		    found_msymbol = true;
-		}
+	      /* An important side-effect of these lookup functions is
+		 to expand the symbol table if msymbol is found, later
+		 in the process we will add matching symbols or
+		 msymbols to the results list, and that requires that
+		 the symbols tables are expanded.  */
+	      if ((kind & SEARCH_FUNCTION_DOMAIN) != 0
+		  ? (find_pc_compunit_symtab
+		     (msymbol->value_address (objfile)) == NULL)
+		  : (lookup_symbol_in_objfile_from_linkage_name
+		     (objfile, msymbol->linkage_name (),
+		      SEARCH_VFT)
+		     .symbol == NULL))
+		found_msymbol = true;
 	    }
-	}
-    }
+
+	  return true;
+	});
 
   return found_msymbol;
 }
@@ -4974,7 +5234,7 @@ global_symbol_searcher::expand_symtabs
 bool
 global_symbol_searcher::add_matching_symbols
 	(objfile *objfile,
-	 const std::optional<compiled_regex> &preg,
+	 const name_matcher &preg,
 	 const std::optional<compiled_regex> &treg,
 	 std::set<symbol_search> *result_set) const
 {
@@ -5009,8 +5269,7 @@ global_symbol_searcher::add_matching_symbols
 	      if (!sym->matches (kind))
 		continue;
 
-	      if (preg.has_value () && preg->exec (sym->natural_name (), 0,
-						   nullptr, 0) != 0)
+	      if (!preg.matches (sym->natural_name ()))
 		continue;
 
 	      if (((sym->domain () == VAR_DOMAIN
@@ -5053,46 +5312,43 @@ global_symbol_searcher::add_matching_symbols
 
 bool
 global_symbol_searcher::add_matching_msymbols
-	(objfile *objfile, const std::optional<compiled_regex> &preg,
+	(objfile *objfile, const name_matcher &preg,
 	 std::vector<symbol_search> *results) const
 {
   domain_search_flags kind = m_kind;
 
-  for (minimal_symbol *msymbol : objfile->msymbols ())
-    {
-      QUIT;
+  return iterate_over_candidate_msymbols
+    (objfile, preg.literals, [&] (minimal_symbol *msymbol)
+      {
+	QUIT;
 
-      if (msymbol->created_by_gdb)
-	continue;
+	if (msymbol->created_by_gdb)
+	  return true;
 
-      if (is_suitable_msymbol (kind, msymbol))
-	{
-	  if (!preg.has_value ()
-	      || preg->exec (msymbol->natural_name (), 0,
-			     NULL, 0) == 0)
-	    {
-	      /* For functions we can do a quick check of whether the
-		 symbol might be found via find_pc_symtab.  */
-	      if ((kind & SEARCH_FUNCTION_DOMAIN) == 0
-		  || (find_pc_compunit_symtab
-		      (msymbol->value_address (objfile)) == NULL))
-		{
-		  if (lookup_symbol_in_objfile_from_linkage_name
-		      (objfile, msymbol->linkage_name (),
-		       SEARCH_VFT).symbol == NULL)
-		    {
-		      /* Matching msymbol, add it to the results list.  */
-		      if (results->size () < m_max_search_results)
-			results->emplace_back (GLOBAL_BLOCK, msymbol, objfile);
-		      else
-			return false;
-		    }
-		}
-	    }
-	}
-    }
+	if (is_suitable_msymbol (kind, msymbol)
+	    && preg.matches (msymbol->natural_name ()))
+	  {
+	    /* For functions we can do a quick check of whether the
+	       symbol might be found via find_pc_symtab.  */
+	    if ((kind & SEARCH_FUNCTION_DOMAIN) == 0
+		|| (find_pc_compunit_symtab
+		    (msymbol->value_address (objfile)) == NULL))
+	      {
+		if (lookup_symbol_in_objfile_from_linkage_name
+		    (objfile, msymbol->linkage_name (),
+		     SEARCH_VFT).symbol == NULL)
+		  {
+		    /* Matching msymbol, add it to the results list.  */
+		    if (results->size () < m_max_search_results)
+		      results->emplace_back (GLOBAL_BLOCK, msymbol, objfile);
+		    else
+		      return false;
+		  }
+	      }
+	  }
 
-  return true;
+	return true;
+      });
 }
 
 /* See symtab.h.  */
@@ -5100,7 +5356,7 @@ global_symbol_searcher::add_matching_msymbols
 std::vector<symbol_search>
 global_symbol_searcher::search () const
 {
-  std::optional<compiled_regex> preg;
+  name_matcher preg;
   std::optional<compiled_regex> treg;
 
   if (m_symbol_name_regexp != NULL)
@@ -5143,8 +5399,12 @@ global_symbol_searcher::search () const
 
       int cflags = REG_NOSUB | (case_sensitivity == case_sensitive_off
 				? REG_ICASE : 0);
-      preg.emplace (symbol_name_regexp, cflags,
-		    _("Invalid regexp"));
+      preg.regex.emplace (symbol_name_regexp, cflags,
+			  _("Invalid regexp"));
+
+      /* The literals are matched case-sensitively.  */
+      if ((cflags & REG_ICASE) == 0)
+	preg.literals = regex_required_literals (symbol_name_regexp);
     }
 
   if (m_symbol_type_regexp != NULL)
@@ -7254,6 +7514,20 @@ If zero then the symbol cache is disabled."),
 			     &maintenance_set_cmdlist,
 			     &maintenance_show_cmdlist);
 
+  add_setshow_boolean_cmd ("symbol-search-index", class_maintenance,
+			   &symbol_search_index,
+			   _("Set whether to index minimal symbol names."),
+			   _("Show whether to index minimal symbol names."),
+			   _("\
+When on, regexp searches of minimal symbols, as done by \"info functions\",\n\
+\"info variables\" and \"rbreak\", use an index of the trigrams of their\n\
+names to only consider the symbols that may match.  The index of each\n\
+object file is built on first use and takes memory proportional to the\n\
+total length of its symbol names."),
+			   set_symbol_search_index, nullptr,
+			   &maintenance_set_cmdlist,
+			   &maintenance_show_cmdlist);
+
   add_setshow_boolean_cmd ("ignore-prologue-end-flag", no_class,
 			   &ignore_prologue_end_flag,
 			   _("Set if the PROLOGUE-END flag is ignored."),
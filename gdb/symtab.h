@@ -2677,11 +2677,24 @@ class global_symbol_searcher
      of SIZE_MAX, there is no "unlimited".  */
   size_t m_max_search_results = SIZE_MAX;
 
+  /* The regular expression used to match symbol names, if any, along
+     with literal strings that every matching name must contain.  The
+     literals are used to cheaply reject most names before running the
+     regular expression, and to look up candidate minimal symbols in
+     a trigram index.  */
+  struct name_matcher
+  {
+    std::optional<compiled_regex> regex;
+    std::vector<std::string> literals;
+
+    /* Return true if NAME matches.  */
+    bool matches (const char *name) const;
+  };
+
   /* Expand symtabs in OBJFILE that match PREG, are of type M_KIND.  Return
      true if any msymbols were seen that we should later consider adding to
      the results list.  */
-  bool expand_symtabs (objfile *objfile,
-		       const std::optional<compiled_regex> &preg) const;
+  bool expand_symtabs (objfile *objfile, const name_matcher &preg) const;
 
   /* Add symbols from symtabs in OBJFILE that match PREG, and TREG, and are
      of type M_KIND, to the results set RESULTS_SET.  Return false if we
@@ -2690,7 +2703,7 @@ class global_symbol_searcher
      Returning true does not indicate that any results were added, just
      that we didn't _not_ add a result due to reaching MAX_SEARCH_RESULTS.  */
   bool add_matching_symbols (objfile *objfile,
-			     const std::optional<compiled_regex> &preg,
+			     const name_matcher &preg,
 			     const std::optional<compiled_regex> &treg,
 			     std::set<symbol_search> *result_set) const;
 
@@ -2701,7 +2714,7 @@ class global_symbol_searcher
      does not indicate that any results were added, just that we didn't
      _not_ add a result due to reaching MAX_SEARCH_RESULTS.  */
   bool add_matching_msymbols (objfile *objfile,
-			      const std::optional<compiled_regex> &preg,
+			      const name_matcher &preg,
 			      std::vector<symbol_search> *results) const;
 
   /* Return true if MSYMBOL is of type KIND.  */
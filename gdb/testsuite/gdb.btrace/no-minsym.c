@@ -0,0 +1,50 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright 2025 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+/* FUNC_NODEBUG has a minimal symbol but no debug info.  FUNC_DEBUG,
+   which follows it, has debug info but no minimal symbol, as the test
+   strips its symbols after linking.  */
+
+extern void func_nodebug (void);
+extern void func_debug (void);
+
+asm (".text\n"
+     ".globl func_nodebug\n"
+     ".type func_nodebug, %function\n"
+     "func_nodebug:\n"
+     "  nop\n"
+     "  ret\n"
+     ".globl func_debug\n"
+     "func_debug:\n"
+     "  nop\n"
+     "  ret\n"
+     ".globl func_debug_end\n"
+     "func_debug_end:\n");
+
+void
+marker (void)
+{
+}
+
+int
+main (void)
+{
+  func_nodebug ();
+  func_debug ();
+  marker ();
+  return 0;
+}
@@ -0,0 +1,44 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright 2025 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+struct point
+{
+  int x;
+  int y;
+};
+
+struct point points[4];
+
+int
+main (void)
+{
+  struct point local = { 1, 2 };
+  int i;
+
+  for (i = 0; i < 4; i++)
+    {
+      points[i].x = i;
+      points[i].y = -i;
+    }
+
+  points[0].x = 0;	/* first stop */
+  points[1].x = 10;
+  points[3].y = 30;
+  local.y = 20;
+
+  return 0;		/* second stop */
+}
@@ -0,0 +1,61 @@
+# Copyright (C) 2025 Free Software Foundation, Inc.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import gdb
+
+
+class ContainerPrinter(gdb.ValuePrinter):
+    def __init__(self, val):
+        self.__val = val
+
+    def to_string(self):
+        return "container of %d" % int(self.__val["len"])
+
+    def display_hint(self):
+        return "array"
+
+    def child_locations(self):
+        items = self.__val["items"]
+        elt_type = items.type.target()
+        addr = int(items)
+        for i in range(int(self.__val["len"])):
+            yield ("[%d]" % i, addr + i * elt_type.sizeof, elt_type)
+
+
+# Same as above, but not derived from gdb.ValuePrinter, so the
+# child_locations method is never used.
+class UntaggedPrinter:
+    def __init__(self, val):
+        self.val = val
+
+    def to_string(self):
+        return "untagged"
+
+    def child_locations(self):
+        raise RuntimeError("child_locations called")
+
+    def children(self):
+        yield ("len", self.val["len"])
+
+
+def lookup(val):
+    if val.type.strip_typedefs().tag == "container":
+        if gdb.convenience_variable("untagged"):
+            return UntaggedPrinter(val)
+        return ContainerPrinter(val)
+    return None
+
+
+gdb.pretty_printers.append(lookup)
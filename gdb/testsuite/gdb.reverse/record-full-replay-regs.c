@@ -0,0 +1,44 @@
+/* This testcase is part of GDB, the GNU debugger.
+
+   Copyright 2025 Free Software Foundation, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+int global;
+
+int
+compute (int a, int b)
+{
+  int x = a * 3;
+  int y = b + x;
+
+  global += y;
+  return x ^ y;
+}
+
+int
+main (void)
+{
+  int r = 0;
+  int i;
+
+  r = compute (1, 2);		/* start of recording */
+  for (i = 0; i < 10; i++)
+    r += compute (i, r);
+  global = r;			/* middle of recording */
+  for (i = 0; i < 10; i++)
+    r -= compute (r, i);
+
+  return r;			/* end of recording */
+}
@@ -26,6 +26,7 @@
 #include "gdbarch.h"
 #include "gdbsupport/buildargv.h"
 #include "inferior.h"
+#include "event-top.h"
 
 /* Helper macros.  */
 
@@ -56,6 +57,78 @@ struct trace_file_writer_deleter
 typedef std::unique_ptr<trace_file_writer, trace_file_writer_deleter>
     trace_file_writer_up;
 
+/* Reads the raw trace buffer of the target through a local window.
+   Parsing the trace frames reads them a field at a time; without the
+   window, each of those reads would be a separate request to the
+   target, that is, a round trip to the remote stub.  */
+
+class raw_trace_data_reader
+{
+public:
+  /* SIZE is the size of the window; no single read may be larger.  */
+  explicit raw_trace_data_reader (size_t size)
+    : m_buf (size)
+  {
+  }
+
+  DISABLE_COPY_AND_ASSIGN (raw_trace_data_reader);
+
+  /* Return a pointer to the LEN bytes of trace data at OFFSET, or
+     NULL if the trace data ends before them.  The pointer is valid
+     until the next call.  */
+  const gdb_byte *get (ULONGEST offset, size_t len)
+  {
+    gdb_assert (len <= m_buf.size ());
+
+    if (offset < m_start || offset + len > m_start + m_len)
+      {
+	/* Refill the window starting at OFFSET, reading as much as
+	   the target will give, to save round trips later.  */
+	m_start = offset;
+	m_len = 0;
+	while (m_len < m_buf.size ())
+	  {
+	    LONGEST gotten
+	      = target_get_raw_trace_data (m_buf.data () + m_len,
+					   m_start + m_len,
+					   m_buf.size () - m_len);
+	    if (gotten < 0)
+	      error (_("Failure to get requested trace buffer data"));
+	    if (gotten == 0)
+	      break;
+	    m_len += gotten;
+	  }
+
+	if (m_len < len)
+	  return nullptr;
+      }
+
+    return m_buf.data () + (offset - m_start);
+  }
+
+  /* Like get, but throw an error if the data is not there.  */
+  const gdb_byte *get_or_error (ULONGEST offset, size_t len)
+  {
+    const gdb_byte *data = get (offset, len);
+    if (data == nullptr)
+      error (_("Failure to get requested trace buffer data"));
+    return data;
+  }
+
+private:
+  /* The window.  */
+  gdb::byte_vector m_buf;
+
+  /* The offset in the trace buffer of the start of the window, and the
+     number of valid bytes in it.  */
+  ULONGEST m_start = 0;
+  size_t m_len = 0;
+};
+
+/* The size of the window used by raw_trace_data_reader.  */
+
+#define TRACE_DATA_WINDOW_SIZE (64 * 1024)
+
 /* Save tracepoint data to file named FILENAME through WRITER.  WRITER
    determines the trace file format.  If TARGET_DOES_SAVE is non-zero,
    the save is performed on the target, otherwise GDB obtains all trace
@@ -136,10 +209,16 @@ trace_save (const char *filename, struct trace_file_writer *writer,
   writer->ops->write_definition_end (writer);
 
   /* Get and write the trace data proper.  */
+  raw_trace_data_reader reader (std::max (TRACE_DATA_WINDOW_SIZE,
+					  trace_regblock_size));
+  /* The frame writers take non-const buffers.  */
+  gdb::byte_vector copy;
   while (1)
     {
       LONGEST gotten = 0;
 
+      QUIT;
+
       /* The writer supports writing the contents of trace buffer
 	  directly to trace file.  Don't parse the contents of trace
 	  buffer.  */
@@ -162,153 +241,88 @@ trace_save (const char *filename, struct trace_file_writer *writer,
 	}
       else
 	{
-	  uint16_t tp_num;
-	  uint32_t tf_size;
 	  /* Parse the trace buffers according to how data are stored
 	     in trace buffer in GDBserver.  */
 
-	  gotten = target_get_raw_trace_data (buf.data (), offset, 6);
-
-	  if (gotten == 0)
-	    break;
-
 	  /* Read the first six bytes in, which is the tracepoint
 	     number and trace frame size.  */
-	  tp_num = (uint16_t)
-	    extract_unsigned_integer (&((buf.data ())[0]), 2, byte_order);
+	  const gdb_byte *data = reader.get (offset, 6);
+	  if (data == nullptr)
+	    break;
 
-	  tf_size = (uint32_t)
-	    extract_unsigned_integer (&((buf.data ())[2]), 4, byte_order);
+	  uint16_t tp_num
+	    = (uint16_t) extract_unsigned_integer (&data[0], 2, byte_order);
+	  uint32_t tf_size
+	    = (uint32_t) extract_unsigned_integer (&data[2], 4, byte_order);
 
 	  writer->ops->frame_ops->start (writer, tp_num);
-	  gotten = 6;
+	  offset += 6;
 
-	  if (tf_size > 0)
+	  for (ULONGEST frame_end = offset + tf_size; offset < frame_end; )
 	    {
-	      unsigned int block;
+	      gdb_byte block_type = *reader.get_or_error (offset, 1);
+	      offset += 1;
 
-	      offset += 6;
-
-	      for (block = 0; block < tf_size; )
+	      switch (block_type)
 		{
-		  gdb_byte block_type;
-
-		  /* We'll fetch one block each time, in order to
-		     handle the extremely large 'M' block.  We first
-		     fetch one byte to get the type of the block.  */
-		  gotten = target_get_raw_trace_data (buf.data (),
-						      offset, 1);
-		  if (gotten < 1)
-		    error (_("Failure to get requested trace buffer data"));
-
-		  gotten = 1;
-		  block += 1;
-		  offset += 1;
-
-		  block_type = buf[0];
-		  switch (block_type)
-		    {
-		    case 'R':
-		      gotten
-			= target_get_raw_trace_data (buf.data (), offset,
-						     trace_regblock_size);
-		      if (gotten < trace_regblock_size)
-			error (_("Failure to get requested trace"
-				 " buffer data"));
-
-		      TRACE_WRITE_R_BLOCK (writer, buf.data (),
-					   trace_regblock_size);
-		      break;
-		    case 'M':
-		      {
-			unsigned short mlen;
-			ULONGEST addr;
-			LONGEST t;
-			int j;
-
-			t = target_get_raw_trace_data (buf.data (),
-						       offset, 10);
-			if (t < 10)
-			  error (_("Failure to get requested trace"
-				   " buffer data"));
-
-			offset += 10;
-			block += 10;
-
-			gotten = 0;
-			addr = (ULONGEST)
-			  extract_unsigned_integer (buf.data (), 8,
-						    byte_order);
-			mlen = (unsigned short)
-			  extract_unsigned_integer (&((buf.data ())[8]), 2,
-						    byte_order);
-
-			TRACE_WRITE_M_BLOCK_HEADER (writer, addr,
-						    mlen);
-
-			/* The memory contents in 'M' block may be
-			   very large.  Fetch the data from the target
-			   and write them into file one by one.  */
-			for (j = 0; j < mlen; )
-			  {
-			    unsigned int read_length;
-
-			    if (mlen - j > MAX_TRACE_UPLOAD)
-			      read_length = MAX_TRACE_UPLOAD;
-			    else
-			      read_length = mlen - j;
-
-			    t = target_get_raw_trace_data (buf.data (),
-							   offset + j,
-							   read_length);
-			    if (t < read_length)
-			      error (_("Failure to get requested"
-				       " trace buffer data"));
-
-			    TRACE_WRITE_M_BLOCK_MEMORY (writer,
-							buf.data (),
-							read_length);
-
-			    j += read_length;
-			    gotten += read_length;
-			  }
-
-			break;
-		      }
-		    case 'V':
+		case 'R':
+		  data = reader.get_or_error (offset, trace_regblock_size);
+		  copy.assign (data, data + trace_regblock_size);
+		  TRACE_WRITE_R_BLOCK (writer, copy.data (),
+				       trace_regblock_size);
+		  offset += trace_regblock_size;
+		  break;
+
+		case 'M':
+		  {
+		    data = reader.get_or_error (offset, 10);
+		    ULONGEST addr
+		      = (ULONGEST) extract_unsigned_integer (data, 8,
+							     byte_order);
+		    unsigned short mlen
+		      = (unsigned short) extract_unsigned_integer (&data[8], 2,
+								   byte_order);
+		    offset += 10;
+
+		    TRACE_WRITE_M_BLOCK_HEADER (writer, addr, mlen);
+
+		    /* The memory contents in 'M' block may be very
+		       large.  Write them into file piece by piece.  */
+		    for (unsigned int j = 0; j < mlen; )
 		      {
-			int vnum;
-			LONGEST val;
-
-			gotten
-			  = target_get_raw_trace_data (buf.data (),
-						       offset, 12);
-			if (gotten < 12)
-			  error (_("Failure to get requested"
-				   " trace buffer data"));
-
-			vnum  = (int) extract_signed_integer (buf.data (),
-							      4,
-							      byte_order);
-			val
-			  = extract_signed_integer (&((buf.data ())[4]),
-						    8, byte_order);
-
-			TRACE_WRITE_V_BLOCK (writer, vnum, val);
+			unsigned int read_length
+			  = std::min<unsigned int> (mlen - j,
+						    MAX_TRACE_UPLOAD);
+
+			data = reader.get_or_error (offset + j, read_length);
+			copy.assign (data, data + read_length);
+			TRACE_WRITE_M_BLOCK_MEMORY (writer, copy.data (),
+						    read_length);
+			j += read_length;
 		      }
-		      break;
-		    default:
-		      error (_("Unknown block type '%c' (0x%x) in"
-			       " trace frame"),
-			     block_type, block_type);
-		    }
-
-		  block += gotten;
-		  offset += gotten;
+		    offset += mlen;
+		  }
+		  break;
+
+		case 'V':
+		  {
+		    data = reader.get_or_error (offset, 12);
+		    int vnum
+		      = (int) extract_signed_integer (data, 4, byte_order);
+		    LONGEST val
+		      = extract_signed_integer (&data[4], 8, byte_order);
+
+		    TRACE_WRITE_V_BLOCK (writer, vnum, val);
+		    offset += 12;
+		  }
+		  break;
+
+		default:
+		  error (_("Unknown block type '%c' (0x%x) in"
+			   " trace frame"),
+			 block_type, block_type);
 		}
 	    }
-	  else
-	    offset += gotten;
 
 	  writer->ops->frame_ops->end (writer);
 	}
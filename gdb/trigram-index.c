@@ -0,0 +1,310 @@
+/* Trigram index for substring and regexp searches over names.
+
+   Copyright (C) 2025 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "trigram-index.h"
+#include <algorithm>
+
+/* Remove the last character from LITERAL, which is being made
+   optional by a following repetition operator.  A multi-byte
+   character is removed entirely.  */
+
+static void
+drop_last_char (std::string &literal)
+{
+  if (literal.empty ())
+    return;
+
+  if ((literal.back () & 0x80) == 0)
+    literal.pop_back ();
+  else
+    while (!literal.empty () && (literal.back () & 0x80) != 0)
+      literal.pop_back ();
+}
+
+/* See trigram-index.h.  */
+
+std::vector<std::string>
+regex_required_literals (const char *regex)
+{
+  std::vector<std::string> result;
+  std::string current;
+
+  auto flush = [&] ()
+    {
+      if (!current.empty ())
+	result.push_back (std::move (current));
+      current.clear ();
+    };
+
+  for (const char *p = regex; *p != '\0'; ++p)
+    {
+      switch (*p)
+	{
+	case '*':
+	  drop_last_char (current);
+	  flush ();
+	  break;
+
+	case '[':
+	  {
+	    /* Skip the bracket expression.  A ']' right after the
+	       opening bracket (or its negation) is part of the set.  */
+	    flush ();
+	    ++p;
+	    if (*p == '^')
+	      ++p;
+	    if (*p == ']')
+	      ++p;
+	    while (*p != ']')
+	      {
+		if (*p == '\0')
+		  return {};
+		if (*p == '[' && (p[1] == ':' || p[1] == '.' || p[1] == '='))
+		  {
+		    char delim = p[1];
+
+		    p += 2;
+		    while (*p != '\0' && !(*p == delim && p[1] == ']'))
+		      ++p;
+		    if (*p == '\0')
+		      return {};
+		    ++p;
+		  }
+		++p;
+	      }
+	  }
+	  break;
+
+	case '\\':
+	  ++p;
+	  switch (*p)
+	    {
+	    case '\0':
+	      return {};
+
+	    case '.':
+	    case '*':
+	    case '[':
+	    case ']':
+	    case '^':
+	    case '$':
+	    case '\\':
+	      current += *p;
+	      break;
+
+	    case '|':
+	      /* Alternation, nothing is required any more.  */
+	      return {};
+
+	    case '(':
+	      {
+		/* Skip the group; its contents may be repeated zero
+		   times, or contain an alternation.  */
+		int depth = 1;
+
+		flush ();
+		while (depth > 0)
+		  {
+		    ++p;
+		    if (*p == '\0')
+		      return {};
+		    if (*p == '\\')
+		      {
+			++p;
+			if (*p == '\0')
+			  return {};
+			if (*p == '(')
+			  ++depth;
+			else if (*p == ')')
+			  --depth;
+		      }
+		  }
+	      }
+	      break;
+
+	    case '{':
+	      /* An interval may allow zero repetitions.  */
+	      drop_last_char (current);
+	      flush ();
+	      while (!(p[0] == '\\' && p[1] == '}'))
+		{
+		  if (*p == '\0')
+		    return {};
+		  ++p;
+		}
+	      ++p;
+	      break;
+
+	    case '?':
+	      drop_last_char (current);
+	      flush ();
+	      break;
+
+	    default:
+	      /* Other escapes either match a single character of some
+		 class, or are assertions.  */
+	      flush ();
+	      break;
+	    }
+	  break;
+
+	case '|':
+	  /* This is a literal in a basic regular expression, but be
+	     careful in case an extended syntax is in use.  */
+	  return {};
+
+	case '.':
+	case '^':
+	case '$':
+	case '+':
+	case '?':
+	case '{':
+	case '}':
+	case '(':
+	case ')':
+	  flush ();
+	  break;
+
+	default:
+	  current += *p;
+	  break;
+	}
+    }
+
+  flush ();
+  return result;
+}
+
+/* See trigram-index.h.  */
+
+bool
+contains_all_literals (const char *name,
+		       const std::vector<std::string> &literals)
+{
+  for (const std::string &literal : literals)
+    if (strstr (name, literal.c_str ()) == nullptr)
+      return false;
+  return true;
+}
+
+/* Return the trigram starting at S.  */
+
+static uint32_t
+trigram_at (const char *s)
+{
+  return (((uint32_t) (unsigned char) s[0] << 16)
+	  | ((uint32_t) (unsigned char) s[1] << 8)
+	  | (uint32_t) (unsigned char) s[2]);
+}
+
+/* See trigram-index.h.  */
+
+void
+trigram_index::add (const char *name, unsigned int id)
+{
+  size_t len = strlen (name);
+  if (len < 3)
+    return;
+
+  std::vector<uint32_t> trigrams;
+  trigrams.reserve (len - 2);
+  for (size_t i = 0; i + 3 <= len; ++i)
+    trigrams.push_back (trigram_at (name + i));
+  std::sort (trigrams.begin (), trigrams.end ());
+  trigrams.erase (std::unique (trigrams.begin (), trigrams.end ()),
+		  trigrams.end ());
+
+  for (uint32_t t : trigrams)
+    {
+      std::vector<unsigned int> &ids = m_postings[t];
+
+      gdb_assert (ids.empty () || ids.back () < id);
+      ids.push_back (id);
+    }
+}
+
+/* See trigram-index.h.  */
+
+void
+trigram_index::shrink_to_fit ()
+{
+  for (auto &entry : m_postings)
+    entry.second.shrink_to_fit ();
+}
+
+/* See trigram-index.h.  */
+
+std::optional<std::vector<unsigned int>>
+trigram_index::candidates (const std::vector<std::string> &literals) const
+{
+  std::vector<uint32_t> trigrams;
+  for (const std::string &literal : literals)
+    for (size_t i = 0; i + 3 <= literal.size (); ++i)
+      trigrams.push_back (trigram_at (literal.c_str () + i));
+
+  if (trigrams.empty ())
+    return {};
+
+  std::sort (trigrams.begin (), trigrams.end ());
+  trigrams.erase (std::unique (trigrams.begin (), trigrams.end ()),
+		  trigrams.end ());
+
+  std::vector<const std::vector<unsigned int> *> lists;
+  for (uint32_t t : trigrams)
+    {
+      auto it = m_postings.find (t);
+      if (it == m_postings.end ())
+	return std::vector<unsigned int> ();
+      lists.push_back (&it->second);
+    }
+
+  /* Intersect the shortest lists first, to keep the intermediate
+     results small.  */
+  std::sort (lists.begin (), lists.end (),
+	     [] (const std::vector<unsigned int> *a,
+		 const std::vector<unsigned int> *b)
+	     {
+	       return a->size () < b->size ();
+	     });
+
+  std::vector<unsigned int> result = *lists[0];
+  std::vector<unsigned int> tmp;
+  for (size_t i = 1; i < lists.size () && !result.empty (); ++i)
+    {
+      tmp.clear ();
+      std::set_intersection (result.begin (), result.end (),
+			     lists[i]->begin (), lists[i]->end (),
+			     std::back_inserter (tmp));
+      std::swap (result, tmp);
+    }
+
+  return result;
+}
+
+/* See trigram-index.h.  */
+
+size_t
+trigram_index::memory_used () const
+{
+  size_t result = 0;
+  for (const auto &entry : m_postings)
+    result += (sizeof (entry)
+	       + entry.second.capacity () * sizeof (unsigned int));
+  return result;
+}
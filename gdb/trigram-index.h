@@ -0,0 +1,74 @@
+/* Trigram index for substring and regexp searches over names.
+
+   Copyright (C) 2025 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#ifndef GDB_TRIGRAM_INDEX_H
+#define GDB_TRIGRAM_INDEX_H
+
+#include "gdbsupport/unordered_map.h"
+
+/* Return a list of strings that any string matched by REGEX must
+   contain.  REGEX is a POSIX basic regular expression, as used by the
+   symbol searching commands.  The analysis is conservative: an empty
+   result means that nothing is known about the matching strings.  */
+
+extern std::vector<std::string> regex_required_literals (const char *regex);
+
+/* Return true if NAME contains every string in LITERALS.  */
+
+extern bool contains_all_literals (const char *name,
+				   const std::vector<std::string> &literals);
+
+/* An index from the three-character substrings ("trigrams") of a set
+   of names to the names containing them.  Names are identified by the
+   caller using unsigned integers.  This is used to quickly find the
+   few names that may contain some literal strings, rather than testing
+   each name in turn.  */
+
+class trigram_index
+{
+public:
+  trigram_index () = default;
+
+  DISABLE_COPY_AND_ASSIGN (trigram_index);
+
+  /* Add NAME, identified by ID, to the index.  Names must be added in
+     increasing order of their IDs.  */
+  void add (const char *name, unsigned int id);
+
+  /* Release the memory that was reserved while adding names.  */
+  void shrink_to_fit ();
+
+  /* Return the IDs of the names that may contain every string in
+     LITERALS, in increasing order.  Every name that does contain them
+     is returned, but some of the returned names may not.  If LITERALS
+     is too short to narrow the search down, return an empty optional,
+     meaning that any name may match.  */
+  std::optional<std::vector<unsigned int>> candidates
+    (const std::vector<std::string> &literals) const;
+
+  /* Return the approximate number of bytes used by the index.  */
+  size_t memory_used () const;
+
+private:
+  /* Map a trigram to the sorted list of IDs of the names containing
+     it.  */
+  gdb::unordered_map<uint32_t, std::vector<unsigned int>> m_postings;
+};
+
+#endif /* GDB_TRIGRAM_INDEX_H */
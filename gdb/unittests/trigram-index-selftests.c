@@ -0,0 +1,105 @@
+/* Self tests for the trigram index.
+
+   Copyright (C) 2025 Free Software Foundation, Inc.
+
+   This file is part of GDB.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+
+#include "gdbsupport/selftest.h"
+#include "trigram-index.h"
+
+namespace selftests {
+namespace trigram_index_tests {
+
+/* Check that the literals required by REGEX are EXPECTED.  */
+
+static void
+check_literals (const char *regex, std::vector<std::string> expected)
+{
+  SELF_CHECK (regex_required_literals (regex) == expected);
+}
+
+static void
+regex_required_literals_tests ()
+{
+  check_literals ("foo", { "foo" });
+  check_literals ("Foo.*Bar", { "Foo", "Bar" });
+  check_literals ("^main$", { "main" });
+  check_literals ("abc*", { "ab" });
+  check_literals ("abc\\?d", { "ab", "d" });
+  check_literals ("abc\\+d", { "abc", "d" });
+  check_literals ("ab\\{0,2\\}cd", { "a", "cd" });
+  check_literals ("a\\.b", { "a.b" });
+  check_literals ("ns::[A-Z][a-z]*::get", { "ns::", "::get" });
+  check_literals ("x[[:alpha:]]]y", { "x", "]y" });
+  check_literals ("pre\\(fix\\)*post", { "pre", "post" });
+  check_literals ("foo\\|bar", {});
+  check_literals ("a\\wb", { "a", "b" });
+  check_literals ("", {});
+  check_literals ("[abc", {});
+}
+
+static void
+trigram_index_tests ()
+{
+  trigram_index index;
+  const char *names[] = { "main", "foo_bar", "bar_foo", "foobar",
+			  "xy", "ns::Foo::getBar" };
+
+  for (unsigned int i = 0; i < ARRAY_SIZE (names); ++i)
+    index.add (names[i], i);
+  index.shrink_to_fit ();
+
+  /* Literals shorter than a trigram don't narrow the search.  */
+  SELF_CHECK (!index.candidates ({ "xy" }).has_value ());
+  SELF_CHECK (!index.candidates ({}).has_value ());
+
+  auto check = [&] (std::vector<std::string> literals,
+		    std::vector<unsigned int> expected)
+    {
+      std::optional<std::vector<unsigned int>> result
+	= index.candidates (literals);
+
+      SELF_CHECK (result.has_value ());
+      SELF_CHECK (*result == expected);
+
+      /* The index may return false positives, but no false
+	 negatives.  */
+      for (unsigned int i = 0; i < ARRAY_SIZE (names); ++i)
+	if (contains_all_literals (names[i], literals))
+	  SELF_CHECK (std::find (result->begin (), result->end (), i)
+		      != result->end ());
+    };
+
+  check ({ "foo" }, { 1, 2, 3 });
+  check ({ "foo", "bar" }, { 1, 2, 3 });
+  check ({ "foo_" }, { 1 });
+  check ({ "main" }, { 0 });
+  check ({ "Foo", "Bar" }, { 5 });
+  check ({ "nothing" }, {});
+}
+
+} /* namespace trigram_index_tests */
+} /* namespace selftests */
+
+INIT_GDB_FILE (trigram_index_selftests)
+{
+  selftests::register_test
+    ("regex_required_literals",
+     selftests::trigram_index_tests::regex_required_literals_tests);
+  selftests::register_test
+    ("trigram_index",
+     selftests::trigram_index_tests::trigram_index_tests);
+}
@@ -1042,13 +1042,14 @@ value_at_lazy (struct type *type, CORE_ADDR addr, const frame_info_ptr &frame)
   return get_value_at (type, addr, frame, 1);
 }
 
+/* See value.h.  */
+
 void
-read_value_memory (struct value *val, LONGEST bit_offset,
-		   bool stack, CORE_ADDR memaddr,
-		   gdb_byte *buffer, size_t length)
+read_value_memory (struct gdbarch *arch, bool stack, CORE_ADDR memaddr,
+		   gdb_byte *buffer, size_t length,
+		   gdb::function_view<void (ULONGEST, ULONGEST)> unavailable)
 {
   ULONGEST xfered_total = 0;
-  struct gdbarch *arch = val->arch ();
   int unit_size = gdbarch_addressable_memory_unit_size (arch);
   enum target_object object;
 
@@ -1069,9 +1070,7 @@ read_value_memory (struct value *val, LONGEST bit_offset,
       if (status == TARGET_XFER_OK)
 	/* nothing */;
       else if (status == TARGET_XFER_UNAVAILABLE)
-	val->mark_bits_unavailable ((xfered_total * HOST_CHAR_BIT
-				     + bit_offset),
-				    xfered_partial * HOST_CHAR_BIT);
+	unavailable (xfered_total, xfered_partial);
       else if (status == TARGET_XFER_EOF)
 	memory_error (TARGET_XFER_E_IO, memaddr + xfered_total);
       else
@@ -1082,6 +1081,22 @@ read_value_memory (struct value *val, LONGEST bit_offset,
     }
 }
 
+/* See value.h.  */
+
+void
+read_value_memory (struct value *val, LONGEST bit_offset,
+		   bool stack, CORE_ADDR memaddr,
+		   gdb_byte *buffer, size_t length)
+{
+  read_value_memory (val->arch (), stack, memaddr, buffer, length,
+		     [&] (ULONGEST offset, ULONGEST len)
+		     {
+		       val->mark_bits_unavailable (offset * HOST_CHAR_BIT
+						   + bit_offset,
+						   len * HOST_CHAR_BIT);
+		     });
+}
+
 /* Store the contents of FROMVAL into the location of TOVAL.
    Return a new value with the location of TOVAL and contents of FROMVAL.  */
 
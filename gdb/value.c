@@ -47,6 +47,7 @@
 #include "completer.h"
 #include "gdbsupport/selftest.h"
 #include "gdbsupport/array-view.h"
+#include "gdbsupport/byte-vector.h"
 #include "cli/cli-style.h"
 #include "expop.h"
 #include "inferior.h"
@@ -4145,6 +4146,121 @@ value::fetch_lazy ()
 
 /* See value.h.  */
 
+void
+value::fetch_lazy_memory_batch (gdb::array_view<value *> vals)
+{
+  /* Upper bound on the size of a single coalesced read.  */
+  const ULONGEST max_read = 64 * 1024;
+
+  struct pending
+  {
+    CORE_ADDR addr;
+    ULONGEST len;
+    value *val;
+  };
+
+  std::vector<pending> todo;
+  for (value *v : vals)
+    {
+      if (v == nullptr || !v->lazy () || v->lval () != lval_memory
+	  || v->m_is_zero || v->bitsize () != 0 || v->m_limited_length > 0)
+	continue;
+
+      struct type *type = check_typedef (v->enclosing_type ());
+      CORE_ADDR addr = v->address ();
+      if (type->length () == 0 || type->length () > max_read
+	  || addr + type->length () < addr
+	  || gdbarch_addressable_memory_unit_size (type->arch ()) != 1)
+	continue;
+
+      todo.push_back ({addr, type->length (), v});
+    }
+
+  if (todo.size () < 2)
+    return;
+
+  /* Stack and other memory may be read differently, so only values of
+     the same kind are read together.  */
+  std::sort (todo.begin (), todo.end (),
+	     [] (const pending &a, const pending &b)
+	     {
+	       if (a.val->stack () != b.val->stack ())
+		 return b.val->stack ();
+	       return a.addr < b.addr;
+	     });
+
+  gdb::byte_vector buf;
+  std::vector<std::pair<ULONGEST, ULONGEST>> unavailable;
+  for (size_t first = 0; first < todo.size ();)
+    {
+      CORE_ADDR start = todo[first].addr;
+      CORE_ADDR end = start + todo[first].len;
+      bool stack = todo[first].val->stack ();
+      size_t last = first + 1;
+
+      /* Only values that touch or overlap are read together, so that no
+	 memory is read that the values do not need.  */
+      while (last < todo.size ()
+	     && todo[last].val->stack () == stack
+	     && todo[last].addr <= end
+	     && (std::max (end, todo[last].addr + todo[last].len) - start
+		 <= max_read))
+	{
+	  end = std::max (end, todo[last].addr + todo[last].len);
+	  ++last;
+	}
+
+      /* A single value gains nothing from being read here, so leave it
+	 lazy.  */
+      if (last - first < 2)
+	{
+	  first = last;
+	  continue;
+	}
+
+      buf.resize (end - start);
+      unavailable.clear ();
+      try
+	{
+	  read_value_memory (todo[first].val->arch (), stack, start,
+			     buf.data (), end - start,
+			     [&] (ULONGEST offset, ULONGEST len)
+			     {
+			       unavailable.emplace_back (offset, len);
+			     });
+	}
+      catch (const gdb_exception_error &ex)
+	{
+	  /* Leave the values lazy, so that the error is reported for
+	     the value that could not be read when it is fetched.  */
+	  first = last;
+	  continue;
+	}
+
+      for (size_t i = first; i < last; ++i)
+	{
+	  value *v = todo[i].val;
+	  ULONGEST offset = todo[i].addr - start;
+
+	  v->allocate_contents (true);
+	  memcpy (v->m_contents.get (), buf.data () + offset, todo[i].len);
+	  for (const auto &[u_offset, u_len] : unavailable)
+	    {
+	      ULONGEST lo = std::max (u_offset, offset);
+	      ULONGEST hi = std::min (u_offset + u_len, offset + todo[i].len);
+
+	      if (lo < hi)
+		v->mark_bytes_unavailable (lo - offset, hi - lo);
+	    }
+	  v->set_lazy (false);
+	}
+
+      first = last;
+    }
+}
+
+/* See value.h.  */
+
 value *
 pseudo_from_raw_part (const frame_info_ptr &next_frame, int pseudo_reg_num,
 		      int raw_reg_num, int raw_offset)
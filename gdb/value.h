@@ -23,6 +23,7 @@
 #include "frame.h"
 #include "extension.h"
 #include "gdbsupport/gdb_ref_ptr.h"
+#include "gdbsupport/function-view.h"
 #include "gmp-utils.h"
 #include "gdbtypes.h"
 
@@ -442,6 +443,13 @@ struct value
      it.  */
   void fetch_lazy ();
 
+  /* Fetch the contents of the lazy memory values in VALS, reading
+     values that are adjacent or overlapping in memory with a single
+     target request.  Values that can't be handled this way, or whose
+     memory could not be read in bulk, are left lazy and will be fetched
+     one by one as usual.  */
+  static void fetch_lazy_memory_batch (gdb::array_view<value *> vals);
+
   /* Compare LENGTH bytes of this value's contents starting at OFFSET1
      with LENGTH bytes of VAL2's contents starting at OFFSET2.
 
@@ -1024,6 +1032,15 @@ extern void read_value_memory (struct value *val, LONGEST bit_offset,
 			       bool stack, CORE_ADDR memaddr,
 			       gdb_byte *buffer, size_t length);
 
+/* Like the above, but for memory that need not be the contents of a
+   single value.  Calls UNAVAILABLE with the offset from MEMADDR and the
+   length, both in addressable memory units, of each part of the memory
+   that is unavailable.  */
+
+extern void read_value_memory
+  (struct gdbarch *arch, bool stack, CORE_ADDR memaddr, gdb_byte *buffer,
+   size_t length, gdb::function_view<void (ULONGEST, ULONGEST)> unavailable);
+
 /* Cast SCALAR_VALUE to the element type of VECTOR_TYPE, then replicate
    into each element of a new vector value with VECTOR_TYPE.  */
 
@@ -606,6 +606,18 @@ install_dynamic_child (struct varobj *var,
       /* There's no child yet.  */
       struct varobj *child = varobj_add_child (var, item);
 
+      if (newobj != NULL)
+	{
+	  newobj->push_back (child);
+	  *cchanged = true;
+	}
+    }
+  else if (var->children[index] == NULL)
+    {
+      /* The child was deleted by the client; create it again.  */
+      varobj *child = create_child_with_value (var, index, item);
+
+      var->children[index] = child;
       if (newobj != NULL)
 	{
 	  newobj->push_back (child);
@@ -723,7 +735,8 @@ update_dynamic_varobj_children (struct varobj *var,
     {
       *cchanged = true;
       for (int j = i; j < var->children.size (); ++j)
-	varobj_delete (var->children[j], 0);
+	if (var->children[j] != NULL)
+	  varobj_delete (var->children[j], 0);
 
       var->children.resize (i);
     }
@@ -792,19 +805,21 @@ varobj_list_children (struct varobj *var, int *from, int *to)
   while (var->children.size () < var->num_children)
     var->children.push_back (NULL);
 
-  for (int i = 0; i < var->num_children; i++)
+  /* Only create the children in the requested range, so that listing
+     a few children of a large array is cheap.  */
+  varobj_restrict_range (var->children, from, to);
+
+  for (int i = *from; i < *to; i++)
     {
       if (var->children[i] == NULL)
 	{
-	  /* Either it's the first call to varobj_list_children for
-	     this variable object, and the child was never created,
-	     or it was explicitly deleted by the client.  */
+	  /* Either the child was never requested before, or it was
+	     explicitly deleted by the client.  */
 	  std::string name = name_of_child (var, i);
 	  var->children[i] = create_child (var, i, name);
 	}
     }
 
-  varobj_restrict_range (var->children, from, to);
   return var->children;
 }
 
@@ -1430,6 +1445,37 @@ varobj_value_has_mutated (const struct varobj *var, struct value *new_value,
     return false;
 }
 
+/* Compute the new value of R's varobj, a child of a varobj that was
+   just updated, and record it in R.  If the value will need to be
+   fetched to be compared with the old one, add it to TO_FETCH.  */
+
+static void
+compute_child_value_early (varobj_update_result &r,
+			   std::vector<value *> &to_fetch)
+{
+  varobj *v = r.varobj;
+  value *val;
+
+  try
+    {
+      val = value_of_child (v->parent, v->index);
+    }
+  catch (const gdb_exception_error &)
+    {
+      /* Leave it to varobj_update to compute the value, and report
+	 the error.  */
+      return;
+    }
+
+  r.value_computed = true;
+  if (val == nullptr)
+    return;
+
+  r.new_value = value_ref_ptr::new_reference (val);
+  if (val->lazy () && v->type != nullptr && varobj_value_is_changeable_p (v))
+    to_fetch.push_back (val);
+}
+
 /* Update the values for a variable and its children.  This is a
    two-pronged attack.  First, re-parse the value for the root's
    expression to see if it's changed.  Then go all the way
@@ -1514,7 +1560,10 @@ varobj_update (struct varobj **varp, bool is_explicit)
 	{
 	  struct type *new_type;
 
-	  newobj = value_of_child (v->parent, v->index);
+	  if (r.value_computed)
+	    newobj = r.new_value.get ();
+	  else
+	    newobj = value_of_child (v->parent, v->index);
 	  if (update_type_if_necessary (v, newobj))
 	    r.type_changed = true;
 	  if (newobj)
@@ -1632,15 +1681,25 @@ varobj_update (struct varobj **varp, bool is_explicit)
       /* Push any children.  Use reverse order so that the first
 	 child is popped from the work stack first, and so
 	 will be added to result first.  This does not
-	 affect correctness, just "nicer".  */
+	 affect correctness, just "nicer".
+
+	 The children's new values are computed now, so that the
+	 memory of all of them can be read at once.  */
+      std::vector<value *> to_fetch;
       for (int i = v->children.size () - 1; i >= 0; --i)
 	{
 	  varobj *c = v->children[i];
 
 	  /* Child may be NULL if explicitly deleted by -var-delete.  */
 	  if (c != NULL && !c->frozen)
-	    stack.emplace_back (c);
+	    {
+	      varobj_update_result item (c);
+
+	      compute_child_value_early (item, to_fetch);
+	      stack.push_back (std::move (item));
+	    }
 	}
+      value::fetch_lazy_memory_batch (to_fetch);
 
       if (r.changed || r.type_changed)
 	result.push_back (std::move (r));
@@ -2206,8 +2265,9 @@ varobj_value_get_print_value (struct value *value,
 	  else
 	    {
 	      /* No to_string method, so if there is a 'children'
-		 method, return the default.  */
-	      if (PyObject_HasAttr (value_formatter, gdbpy_children_cst))
+		 or 'child_locations' method, return the default.  */
+	      if (PyObject_HasAttr (value_formatter, gdbpy_children_cst)
+		  || gdbpy_has_child_locations (value_formatter))
 		return "{...}";
 	    }
 	}
@@ -78,6 +78,11 @@ struct varobj_update_result
      be yet installed.  Don't use this outside varobj.c.  */
   bool value_installed = false;
 
+  /* Likewise, these are used internally by varobj_update to hold the
+     new value of varobj when it was computed ahead of time.  */
+  bool value_computed = false;
+  value_ref_ptr new_value;
+
   /* This will be non-NULL when new children were added to the varobj.
      It lists the new children (which must necessarily come at the end
      of the child list) added during an update.  The caller is
@@ -286,7 +291,9 @@ extern int varobj_get_num_children (struct varobj *var);
    return, *FROM and *TO will be updated to indicate the real range
    that was returned.  The resulting vector will contain at least the
    children from *FROM to just before *TO; it might contain more
-   children, depending on whether any more were available.  */
+   children, depending on whether any more were available.  Children
+   outside of that range are only created when requested, so their
+   elements may be NULL.  */
 extern const std::vector<varobj *> &
   varobj_list_children (struct varobj *var, int *from, int *to);
 
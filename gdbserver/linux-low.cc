@@ -3341,9 +3341,8 @@ linux_process_target::wait_1 (ptid_t ptid, target_waitstatus *ourstatus,
 		       && !step_over_finished
 		       && !(current_thread->last_resume_kind == resume_continue
 			    && event_child->stop_reason == TARGET_STOPPED_BY_SINGLE_STEP))
-		   || (gdb_breakpoint_here (event_child->stop_pc)
-		       && gdb_condition_true_at_breakpoint (event_child->stop_pc)
-		       && gdb_no_commands_at_breakpoint (event_child->stop_pc))
+		   || gdb_breakpoint_should_report (event_child->stop_pc,
+						    &event_child->bp_report_cache)
 		   || event_child->waitstatus.kind () != TARGET_WAITKIND_IGNORE);
 
   run_breakpoint_commands (event_child->stop_pc);
@@ -4193,6 +4192,7 @@ linux_process_target::resume_one_lwp_throw (lwp_info *lwp, int step,
      otherwise handle_zombie_lwp_error would get confused.  */
   lwp->stopped = 0;
   lwp->stop_reason = TARGET_STOPPED_BY_NO_REASON;
+  lwp->bp_report_cache.valid = false;
 }
 
 void
@@ -4463,9 +4463,7 @@ linux_process_target::thread_needs_step_over (thread_info *thread)
       /* Don't step over a breakpoint that GDB expects to hit
 	 though.  If the condition is being evaluated on the target's side
 	 and it evaluate to false, step over this breakpoint as well.  */
-      if (gdb_breakpoint_here (pc)
-	  && gdb_condition_true_at_breakpoint (pc)
-	  && gdb_no_commands_at_breakpoint (pc))
+      if (gdb_breakpoint_should_report (pc, &lwp->bp_report_cache))
 	{
 	  threads_debug_printf ("Need step over [LWP %ld]? yes, but found"
 				" GDB breakpoint at 0x%s; skipping step over",
@@ -848,6 +848,10 @@ struct lwp_info
      running, this is the address at which the lwp was resumed.  */
   CORE_ADDR stop_pc = 0;
 
+  /* Whether GDB should be told about a breakpoint hit at STOP_PC,
+     computed at most once per stop.  */
+  gdb_breakpoint_report_cache bp_report_cache;
+
   /* If this flag is set, STATUS_PENDING is a waitstatus that has not yet
      been reported.  */
   int status_pending_p = 0;
@@ -927,6 +927,13 @@ release_breakpoint (struct process_info *proc, struct breakpoint *bp)
   return 0;
 }
 
+/* Incremented whenever a GDB breakpoint is added or deleted, its
+   conditions or commands change, or GDB writes the inferior's memory
+   or registers.  This invalidates the results cached by
+   gdb_breakpoint_should_report.  */
+
+static unsigned int gdb_breakpoints_generation;
+
 static int
 delete_breakpoint_1 (struct process_info *proc, struct breakpoint *todel)
 {
@@ -964,6 +971,9 @@ int
 delete_breakpoint (struct breakpoint *todel)
 {
   struct process_info *proc = current_process ();
+
+  if (is_gdb_breakpoint (todel->type))
+    ++gdb_breakpoints_generation;
   return delete_breakpoint_1 (proc, todel);
 }
 
@@ -1022,6 +1032,8 @@ set_gdb_breakpoint (char z_type, CORE_ADDR addr, int kind, int *err)
       return nullptr;
     }
 
+  ++gdb_breakpoints_generation;
+
   /* If we see GDB inserting a second code breakpoint at the same
      address, then either: GDB is updating the breakpoint's conditions
      or commands; or, the first breakpoint must have disappeared due
@@ -1124,6 +1136,7 @@ clear_breakpoint_conditions (struct gdb_breakpoint *bp)
   if (bp->cond_list == NULL)
     return;
 
+  ++gdb_breakpoints_generation;
   cond = bp->cond_list;
 
   while (cond != NULL)
@@ -1149,6 +1162,7 @@ clear_breakpoint_commands (struct gdb_breakpoint *bp)
   if (bp->command_list == NULL)
     return;
 
+  ++gdb_breakpoints_generation;
   cmd = bp->command_list;
 
   while (cmd != NULL)
@@ -1186,6 +1200,7 @@ add_condition_to_breakpoint (struct gdb_breakpoint *bp,
   /* Add condition to the list.  */
   new_cond->next = bp->cond_list;
   bp->cond_list = new_cond;
+  ++gdb_breakpoints_generation;
 }
 
 /* Add a target-side condition CONDITION to a breakpoint.  */
@@ -1284,6 +1299,7 @@ add_commands_to_breakpoint (struct gdb_breakpoint *bp,
   /* Add commands to the list.  */
   new_cmd->next = bp->command_list;
   bp->command_list = new_cmd;
+  ++gdb_breakpoints_generation;
 }
 
 /* Add a target-side command COMMAND to the breakpoint at ADDR.  */
@@ -1397,6 +1413,34 @@ gdb_breakpoint_here (CORE_ADDR where)
 	  || find_gdb_breakpoint (Z_PACKET_HW_BP, where, -1) != NULL);
 }
 
+/* See mem-break.h.  */
+
+bool
+gdb_breakpoint_should_report (CORE_ADDR where,
+			      gdb_breakpoint_report_cache *cache)
+{
+  if (cache->valid
+      && cache->pc == where
+      && cache->generation == gdb_breakpoints_generation)
+    return cache->result;
+
+  cache->result = (gdb_breakpoint_here (where)
+		   && gdb_condition_true_at_breakpoint (where)
+		   && gdb_no_commands_at_breakpoint (where));
+  cache->pc = where;
+  cache->generation = gdb_breakpoints_generation;
+  cache->valid = true;
+  return cache->result;
+}
+
+/* See mem-break.h.  */
+
+void
+invalidate_gdb_breakpoint_reports ()
+{
+  ++gdb_breakpoints_generation;
+}
+
 void
 set_single_step_breakpoint (CORE_ADDR stop_at, ptid_t ptid)
 {
@@ -142,6 +142,47 @@ void run_breakpoint_commands (CORE_ADDR where);
 
 int gdb_breakpoint_here (CORE_ADDR where);
 
+/* The result of gdb_breakpoint_should_report for one stop of a
+   thread.  */
+
+struct gdb_breakpoint_report_cache
+{
+  /* Whether RESULT is valid.  This must be cleared when the thread is
+     resumed.  */
+  bool valid = false;
+
+  /* The address the result is for.  */
+  CORE_ADDR pc = 0;
+
+  /* The generation of the GDB breakpoints when the result was
+     computed.  */
+  unsigned int generation = 0;
+
+  /* The cached result.  */
+  bool result = false;
+};
+
+/* Return true if a thread stopped at WHERE should report the stop to
+   GDB because of a GDB breakpoint there: that is, if there is a GDB
+   breakpoint at WHERE, its condition is true, and it has no
+   target-side commands.
+
+   The result is cached in *CACHE.  Handling a breakpoint hit needs
+   this both when deciding whether to report the stop, and again when
+   deciding whether to step over the breakpoint before resuming; the
+   cache makes sure that a breakpoint's condition is evaluated only
+   once per hit, which halves the cost of a conditional breakpoint
+   whose condition is false.  */
+
+bool gdb_breakpoint_should_report (CORE_ADDR where,
+				   gdb_breakpoint_report_cache *cache);
+
+/* Invalidate all results cached by gdb_breakpoint_should_report.
+   This must be called when GDB writes to the inferior's memory or
+   registers, as a breakpoint's condition may depend on them.  */
+
+void invalidate_gdb_breakpoint_reports ();
+
 /* Create a new breakpoint at WHERE, and call HANDLER when
    it is hit.  HANDLER should return 1 if the breakpoint
    should be deleted, 0 otherwise.  The type of the created
@@ -1233,6 +1233,11 @@ gdb_write_memory (CORE_ADDR memaddr, const unsigned char *myaddr, int len)
     {
       int ret;
 
+      /* A thread stopped at a breakpoint may have its condition
+	 evaluated again before it is resumed, so it must not see a
+	 result computed with the old memory contents.  */
+      invalidate_gdb_breakpoint_reports ();
+
       if (set_desired_process ())
 	ret = target_write_memory (memaddr, myaddr, len);
       else
@@ -4746,6 +4751,7 @@ process_serial_event (void)
 	    {
 	      regcache = get_thread_regcache (current_thread);
 	      registers_from_string (regcache, &cs.own_buf[1]);
+	      invalidate_gdb_breakpoint_reports ();
 	      write_ok (cs.own_buf);
 	    }
 	}
@@ -2075,15 +2075,74 @@ set_trace_state_variable_getter (int num, LONGEST (*getter) (void))
   tsv->getter = getter;
 }
 
-/* Add a raw traceframe for the given tracepoint.  */
+/* Space allocated in the trace buffer along with the traceframe being
+   collected, for its first blocks.  Every call to trace_buffer_alloc
+   goes through the synchronization protocol with GDBserver in the
+   in-process agent, and the jump pads of all threads are serialized
+   while it runs, so allocating the blocks whose sizes are known in
+   advance together with the traceframe shortens the time the other
+   threads wait.  */
+
+static unsigned char *traceframe_reserved;
+static size_t traceframe_reserved_size;
+
+/* Return the size of the blocks that the leading actions among the
+   NUMACTIONS ACTIONS of a traceframe will add to it, when that size
+   can be known before running them: a register block, or a memory
+   block that fits in one traceframe block.  CTX is the context of the
+   tracepoint hit.  */
+
+static size_t
+traceframe_known_blocks_size (struct tracepoint_hit_ctx *ctx,
+			      struct tracepoint_action **actions,
+			      int numactions)
+{
+  size_t size = 0;
+
+  for (int i = 0; i < numactions; ++i)
+    {
+      if (actions[i]->type == 'M')
+	{
+	  struct collect_memory_action *maction
+	    = (struct collect_memory_action *) actions[i];
+
+	  /* See agent_mem_read.  */
+	  if (maction->len > 65535)
+	    break;
+	  if (maction->len > 0)
+	    size += (1 + sizeof (CORE_ADDR) + sizeof (unsigned short)
+		     + maction->len);
+	}
+      else if (actions[i]->type == 'R')
+	size += 1 + register_cache_size (ctx->regcache ()->tdesc);
+      else
+	break;
+    }
+
+  return size;
+}
+
+/* Add a raw traceframe for the given tracepoint.  RESERVE is the size
+   of the blocks that will be added to the traceframe first, which are
+   allocated at the same time.  */
 
 static struct traceframe *
-add_traceframe (struct tracepoint *tpoint)
+add_traceframe (struct tracepoint *tpoint, size_t reserve = 0)
 {
   struct traceframe *tframe;
 
   tframe
-    = (struct traceframe *) trace_buffer_alloc (sizeof (struct traceframe));
+    = (struct traceframe *) trace_buffer_alloc (sizeof (struct traceframe)
+						+ reserve);
+
+  /* If there is no room for all the blocks at once, fall back to
+     allocating them one by one, so that we save as much as fits.  */
+  if (tframe == NULL && reserve != 0)
+    {
+      reserve = 0;
+      tframe = ((struct traceframe *)
+		trace_buffer_alloc (sizeof (struct traceframe)));
+    }
 
   if (tframe == NULL)
     return NULL;
@@ -2091,6 +2150,9 @@ add_traceframe (struct tracepoint *tpoint)
   tframe->tpnum = tpoint->number;
   tframe->data_size = 0;
 
+  traceframe_reserved = tframe->data;
+  traceframe_reserved_size = reserve;
+
   return tframe;
 }
 
@@ -2105,7 +2167,19 @@ add_traceframe_block (struct traceframe *tframe,
   if (!tframe)
     return NULL;
 
-  block = (unsigned char *) trace_buffer_alloc (amt);
+  if (amt <= traceframe_reserved_size)
+    {
+      block = traceframe_reserved;
+      traceframe_reserved += amt;
+      traceframe_reserved_size -= amt;
+    }
+  else
+    {
+      /* The reserved space must be used up before anything is
+	 allocated after it.  */
+      gdb_assert (traceframe_reserved_size == 0);
+      block = (unsigned char *) trace_buffer_alloc (amt);
+    }
 
   if (!block)
     return NULL;
@@ -2123,6 +2197,7 @@ add_traceframe_block (struct traceframe *tframe,
 static void
 finish_traceframe (struct traceframe *tframe)
 {
+  gdb_assert (traceframe_reserved_size == 0);
   ++traceframe_write_count;
   ++traceframes_created;
 }
@@ -4334,7 +4409,9 @@ collect_data_at_tracepoint (struct tracepoint_hit_ctx *ctx, CORE_ADDR stop_pc,
   trace_debug ("Making new traceframe for tracepoint %d at 0x%s, hit %" PRIu64,
 	       tpoint->number, paddress (tpoint->address), tpoint->hit_count);
 
-  tframe = add_traceframe (tpoint);
+  tframe = add_traceframe (tpoint,
+			   traceframe_known_blocks_size (ctx, tpoint->actions,
+							 tpoint->numactions));
 
   if (tframe)
     {
@@ -4373,7 +4450,10 @@ collect_data_at_step (struct tracepoint_hit_ctx *ctx,
 	       current_step, tpoint->step_count,
 	       tpoint->hit_count);
 
-  tframe = add_traceframe (tpoint);
+  tframe = add_traceframe (tpoint,
+			   traceframe_known_blocks_size (ctx,
+							 tpoint->step_actions,
+							 tpoint->num_step_actions));
 
   if (tframe)
     {
@@ -6031,7 +6111,7 @@ upload_fast_traceframes (void)
 	 tracepoints...  */
       tpoint = find_next_tracepoint_by_number (NULL, ipa_tframe.tpnum);
 
-      tframe = add_traceframe (tpoint);
+      tframe = add_traceframe (tpoint, ipa_tframe.data_size);
       if (tframe == NULL)
 	{
 	  trace_buffer_is_full = 1;
@@ -225,6 +225,13 @@ extern struct bfd_link_hash_entry *bfd_link_hash_lookup
   (struct bfd_link_hash_table *, const char *, bool create,
    bool copy, bool follow);
 
+/* Look up an entry in a link hash table, without creating it and
+   following bfd_link_hash_indirect and bfd_link_hash_warning links,
+   for a string which is looked up many times.  MISS is as for
+   bfd_hash_lookup_again.  */
+extern struct bfd_link_hash_entry *bfd_link_hash_lookup_again
+  (struct bfd_link_hash_table *, const char *, struct bfd_hash_miss *);
+
 /* Look up an entry in the main linker hash table if the symbol might
    be wrapped.  This should only be used for references to an
    undefined symbol, not for definitions of a symbol.  */
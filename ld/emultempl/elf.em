@@ -882,12 +882,14 @@ gld${EMULATION_NAME}_handle_option (int optc)
 
     case OPTION_COMPRESS_DEBUG:
       config.compress_debug = bfd_get_compression_algorithm (optarg);
-      if (strcasecmp (optarg, "zstd") == 0)
+      if (strcasecmp (optarg, "zstd") == 0
+	  || strcasecmp (optarg, "zstd-seekable") == 0)
 	{
 #ifndef HAVE_ZSTD
-	  if (config.compress_debug == COMPRESS_DEBUG_ZSTD)
-	    fatal (_("%P: --compress-debug-sections=zstd: ld is not built "
-		     "with zstd support\n"));
+	  if (config.compress_debug == COMPRESS_DEBUG_ZSTD
+	      || config.compress_debug == COMPRESS_DEBUG_ZSTD_SEEKABLE)
+	    fatal (_("%P: --compress-debug-sections=%s: ld is not built "
+		     "with zstd support\n"), optarg);
 #endif
 	}
       if (config.compress_debug == COMPRESS_UNKNOWN)
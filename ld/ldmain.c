@@ -901,6 +901,10 @@ main (int argc, char **argv)
     case COMPRESS_DEBUG_ZSTD:
       flags = BFD_COMPRESS | BFD_COMPRESS_GABI | BFD_COMPRESS_ZSTD;
       break;
+    case COMPRESS_DEBUG_ZSTD_SEEKABLE:
+      flags = (BFD_COMPRESS | BFD_COMPRESS_GABI | BFD_COMPRESS_ZSTD
+	       | BFD_COMPRESS_ZSTD_SEEKABLE);
+      break;
     default:
       break;
     }
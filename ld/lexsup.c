@@ -2286,7 +2286,7 @@ elf_static_list_options (FILE *file)
   fprintf (file, _("\
   --package-metadata[=JSON]   Generate package metadata note\n"));
   fprintf (file, _("\
-  --compress-debug-sections=[none|zlib|zlib-gnu|zlib-gabi|zstd]\n\
+  --compress-debug-sections=[none|zlib|zlib-gnu|zlib-gabi|zstd|zstd-seekable]\n\
 			      Compress DWARF debug sections\n"));
   fprintf (file, _("\
                                 Default: %s\n"),